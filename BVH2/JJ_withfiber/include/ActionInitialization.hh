@@ -8,6 +8,7 @@ public:
     ActionInitialization();
     virtual ~ActionInitialization();
 
+    virtual void BuildForMaster() const;   // 멀티스레드: 마스터는 RunAction 만 (병합/출력)
     virtual void Build() const;
 };
 
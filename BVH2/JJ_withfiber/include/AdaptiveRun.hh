@@ -0,0 +1,59 @@
+#ifndef ADAPTIVERUN_HH
+#define ADAPTIVERUN_HH
+
+#include "globals.hh"
+
+class G4GenericMessenger;
+
+// ----------------------------------------------------------------------
+// 목표 정밀도까지 이벤트 생성 (마스터 전용 명령)
+//  maxEvents 로 BeamOn 하고, 모든 스레드의 이벤트 결과를 공유 합계에 모아
+//  checkEvery 이벤트마다 상대 불확도를 확인한다. 목표에 도달하면 각 스레드가
+//  다음 이벤트 끝에서 AbortRun(soft) → 진행 중 이벤트는 끝까지 처리.
+//   npe        : 평균 npe 의 상대 오차  sqrt(var/n) / mean
+//   efficiency : npe >= threshold 비율의 상대 오차  sqrt(p(1-p)/n) / p
+//   bin        : hNpe 의 npe = bin 칸 수의 상대 오차 1/sqrt(N)
+//
+//  /veto/adaptive/target efficiency
+//  /veto/adaptive/precision 0.01
+//  /veto/adaptive/threshold 2
+//  /veto/adaptive/run
+// ----------------------------------------------------------------------
+class AdaptiveRun {
+public:
+    enum Target { kMeanNpe = 0, kEfficiency, kBin };
+
+    AdaptiveRun();
+    ~AdaptiveRun();
+
+    void Run();
+
+    static G4bool IsActive() { return fActive; }
+    // EventAction (모든 스레드): 결과 합산 + 수렴했으면 이 스레드의 런 중단
+    static void RecordEvent(G4int npe);
+
+private:
+    void DefineCommands();
+    void SetTarget(const G4String& target);
+    static G4double RelativeError();   // 공유 합계 기준 (mutex 안에서 호출)
+
+    G4GenericMessenger* fMessenger = nullptr;
+
+    static G4bool   fActive;
+    static G4bool   fConverged;
+    static Target   fTarget;
+    static G4double fPrecision;
+    static G4int    fThreshold;
+    static G4int    fBin;
+    static G4int    fCheckEvery;
+    static G4int    fMinEvents;
+    static G4int    fMaxEvents;
+
+    // 공유 합계 (mutex)
+    static G4long   fN;
+    static G4double fSum, fSum2;
+    static G4long   fNAbove, fNBin;
+    static G4double fLastError;
+};
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef BEAMSCAN_HH
+#define BEAMSCAN_HH
+
+#include "globals.hh"
+#include <vector>
+
+class G4GenericMessenger;
+
+// ----------------------------------------------------------------------
+// 입사 위치/각도 효율 스캔 (마스터 전용 명령, 한 번의 BeamOn)
+//  격자점 p 의 이벤트 = event ID / eventsPerPoint → 멀티스레드면 점들이
+//  작업 스레드에 자연스럽게 나뉜다. PrimaryGeneratorAction 이 현재 모드의
+//  입자 (cosmic: 3 GeV μ-, beta: Sr-90/Y-90 e-) 를 0번 세그먼트 신틸 입구면
+//  (-X) 의 (y, z) 에 각 θ (x-z 평면) 로 맞춘다.
+//  결과: RunAction 이 beamScan/ 아래 θ 마다 npe 평균, RMS, 효율 (npe >= threshold) TH2.
+//
+//  /veto/beamscan/ys -4 -2 0 2 4           (mm, 폭 방향)
+//  /veto/beamscan/zs -60 -40 -20 0 20 40 60 (mm, 길이 방향)
+//  /veto/beamscan/thetas 0 30              (deg)
+//  /veto/beamscan/eventsPerPoint 500
+//  /veto/beamscan/threshold 1
+//  /veto/beamscan/run
+// ----------------------------------------------------------------------
+class BeamScan {
+public:
+    BeamScan();
+    ~BeamScan();
+
+    void Run();
+
+    static G4bool IsActive() { return fActive; }
+    static G4int  GetEventsPerPoint() { return fEventsPerPoint; }
+    static G4int  GetThreshold() { return fThreshold; }
+    static G4int  GetNumberOfPoints() { return fYs.size()*fZs.size()*fThetas.size(); }
+    // 점 번호 = (iT*nZ + iZ)*nY + iY
+    static void   GetPoint(G4int point, G4double& y, G4double& z, G4double& theta);
+    static const std::vector<G4double>& GetYs() { return fYs; }
+    static const std::vector<G4double>& GetZs() { return fZs; }
+    static const std::vector<G4double>& GetThetas() { return fThetas; }
+
+private:
+    void DefineCommands();
+    void SetYs(const G4String& list);
+    void SetZs(const G4String& list);
+    void SetThetas(const G4String& list);
+
+    G4GenericMessenger* fMessenger = nullptr;
+
+    static G4bool fActive;
+    static G4int  fEventsPerPoint;
+    static G4int  fThreshold;
+    static std::vector<G4double> fYs, fZs, fThetas;
+};
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef BETASPECTRUM_HH
+#define BETASPECTRUM_HH
+
+#include "globals.hh"
+#include <vector>
+
+// ----------------------------------------------------------------------
+// β- 에너지 스펙트럼 역 CDF 테이블 (샘플링 비용 일정)
+//  dN/dW ∝ F(Z,W) · p W (W0 - W)² · C(W)
+//   F : 상대론적 Fermi 함수 (유한 핵 반지름 R = 1.2 A^(1/3) fm)
+//   C : 1차 금지 unique 모양 인자 p² + q²  (Sr-90, Y-90 모두 2- → 0+)
+//  W, p 는 m_e c² / m_e c 단위, q = W0 - W (중성미자 운동량).
+//
+//  생성 시 조밀한 에너지 격자에서 CDF 를 적분하고, 균일 분위수 격자로
+//  뒤집어 둔다 → Sample() 은 난수 하나 + 선형 보간.
+// ----------------------------------------------------------------------
+class BetaSpectrum {
+public:
+    enum Shape { kAllowed = 0, kUniqueFirstForbidden };
+
+    // zDaughter: 딸핵 원자 번호, a: 질량수, q: 끝점 운동 에너지
+    BetaSpectrum(G4int zDaughter, G4int a, G4double q, Shape shape);
+
+    G4double Sample() const;                       // 운동 에너지
+    G4double Density(G4double ekin) const;         // 정규화된 dN/dE (1/에너지)
+    G4double Cdf(G4double ekin) const;             // 해석 적분 (테이블 격자)
+    G4double GetEndpoint() const { return fQ; }
+    G4double GetMeanEnergy() const { return fMean; }
+
+    // 테이블 검증: n 개 샘플의 CDF 와 기준 CDF (Density 를 10배 조밀한 격자에서
+    //  Simpson 적분, 테이블과 독립) 의 최대 차 (KS 거리), 테이블 CDF 오차, 평균, 속도
+    void Validate(const G4String& name, G4int n) const;
+
+private:
+    G4double Weight(G4double ekin) const;          // 정규화 전 스펙트럼
+    G4double FermiFunction(G4double w) const;
+
+    static const G4int kNGrid     = 2048;          // 적분 격자
+    static const G4int kNQuantile = 4096;          // 역 CDF 격자
+
+    G4int    fZ;
+    G4double fQ;
+    Shape    fShape;
+    G4double fGamma;                                // sqrt(1 - (αZ)²)
+    G4double fRadius;                               // 핵 반지름 (ħ/m_e c 단위)
+    G4double fNorm = 1.;
+    G4double fMean = 0.;
+    std::vector<G4double> fCdf;                     // kNGrid+1 (균일 에너지)
+    std::vector<G4double> fQuantile;                // kNQuantile+1 (균일 u)
+};
+
+#endif
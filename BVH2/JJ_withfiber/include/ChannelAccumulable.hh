@@ -0,0 +1,45 @@
+#ifndef CHANNELACCUMULABLE_HH
+#define CHANNELACCUMULABLE_HH
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <map>
+#include <vector>
+
+// ----------------------------------------------------------------------
+// SiPM 채널별 런 누적 (채널 = 세그먼트 copy number)
+//  발화한 채널만 map 에 생성 → 메모리는 발화 채널 수에 비례.
+//  빔 스캔은 같은 구조를 격자점 번호로 사용 (npe = 0 이벤트 포함, 시각은 npe > 0 만).
+//  npe / 첫 검출 시각 분포는 고정 bin 카운트로 들고 있다가
+//  런 끝에 (스레드 병합 후) RunAction 이 채널별 TH1F 로 기록.
+// ----------------------------------------------------------------------
+class ChannelAccumulable : public G4VAccumulable {
+public:
+    static constexpr G4int kNpeBins  = 80;     // hNpe 와 같은 0-80
+    static constexpr G4int kTimeBins = 100;    // 첫 검출 시각 0-100 ns
+    static const G4double kTimeMax;
+
+    struct Sums {
+        G4int    nFired = 0;        // 이 채널이 발화한 이벤트 수 (빔 스캔: 전체 이벤트 수)
+        G4double npeSum = 0., npeSum2 = 0.;
+        G4double wlSum = 0., wlSum2 = 0., wlN = 0.;
+        std::vector<G4int> npeCounts  = std::vector<G4int>(kNpeBins + 1, 0);   // 마지막 = overflow
+        std::vector<G4int> timeCounts = std::vector<G4int>(kTimeBins + 1, 0);
+    };
+
+    explicit ChannelAccumulable(const G4String& name = "channels");
+    virtual ~ChannelAccumulable() {}
+
+    void Fill(G4int channel, G4int npe, G4double firstTime, G4double wlSum, G4double wlSum2, G4int wlN);
+
+    virtual void Merge(const G4VAccumulable& other) override;
+    virtual void Reset() override;
+
+    const std::map<G4int, Sums>& GetChannels() const { return fChannels; }
+
+private:
+    std::map<G4int, Sums> fChannels;
+};
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef COSMICMUONSPECTRUM_HH
+#define COSMICMUONSPECTRUM_HH
+
+#include "globals.hh"
+#include <vector>
+
+// ----------------------------------------------------------------------
+// 해수면 우주선 뮤온 (E, cosθ) 2D 테이블 + alias 샘플러
+//  강도: Gaisser 식 + Guan et al. (2015) 저에너지/지구 곡률 보정
+//   I(E,θ) = 0.14 [E(1 + 3.64 GeV/(E cos*^1.29))]^-2.7
+//            × [1/(1 + 1.1 E cos*/115 GeV) + 0.054/(1 + 1.1 E cos*/850 GeV)]
+//            (cm² s sr GeV)^-1,  cos* = 곡률 보정 천정각 코사인
+//  셀 = ln E 균일 × cosθ 균일. 셀 가중치 = I·E·Δ(lnE)·Δcosθ·2π
+//  → Sample() 은 alias 로 셀 하나 (난수 2개) + 셀 안 균일 (난수 2개).
+//
+//  GetTotalIntensity() 는 방향에 수직한 단위 면적당 적분 강도:
+//  방향 d 에서 투영 면적 A(d) 인 물체의 계수율 = Φ·<A(d)>.
+//  GetMeanCos()/GetMeanSin() = 강도 가중 <cosθ>, <sinθ> (box 의 <A(d)> 계산용)
+// ----------------------------------------------------------------------
+class CosmicMuonSpectrum {
+public:
+    // eMin/eMax: 뮤온 전체 에너지, cosMin: 허용하는 최소 cos(천정각)
+    CosmicMuonSpectrum(G4double eMin, G4double eMax, G4double cosMin);
+
+    static G4double Intensity(G4double energy, G4double cosTheta); // (cm² s sr GeV)^-1
+
+    void Sample(G4double& energy, G4double& cosTheta) const;
+    G4double GetTotalIntensity() const { return fTotal; }           // 내부 단위 1/(면적·시간)
+    G4double GetMeanCos() const { return fMeanCos; }
+    G4double GetMeanSin() const { return fMeanSin; }
+
+    G4bool Matches(G4double eMin, G4double eMax, G4double cosMin) const {
+        return eMin == fEMin && eMax == fEMax && cosMin == fCosMin;
+    }
+
+    static const G4double kMuPlusOverMinus;   // 1.27 (해수면, 수 GeV~수백 GeV)
+
+private:
+    void BuildAlias(const std::vector<G4double>& weights);
+
+    static const G4int kNE   = 120;
+    static const G4int kNCos = 50;
+
+    G4double fEMin, fEMax, fCosMin;
+    G4double fLogEMin, fDLogE, fDCos;
+    G4double fTotal = 0.;
+    G4double fMeanCos = 0., fMeanSin = 0.;
+    std::vector<G4double> fProb;   // alias: 셀 k 를 그대로 받을 확률
+    std::vector<G4int>    fAlias;  // 아니면 이 셀
+};
+
+#endif
@@ -3,9 +3,13 @@
 
 #include "G4VUserDetectorConstruction.hh"
 #include "G4LogicalVolume.hh"
+#include "G4ThreeVector.hh"
 #include "globals.hh"
+#include <vector>
 
 class G4VPhysicalVolume;
+class G4GenericMessenger;
+class G4OpticalSurface;
 
 class DetectorConstruction : public G4VUserDetectorConstruction {
 public:
@@ -13,10 +17,92 @@ public:
     virtual ~DetectorConstruction();
 
     virtual G4VPhysicalVolume* Construct();
+    virtual void ConstructSDandField();
+
+    // /veto/fiber/...
+    void SetFiberFastSim(G4bool on);
+    void SetFiberEndReflectivity(G4double r);
+
+    // /veto/scint/...
+    void SetYieldScan(const G4String& yields);
+
+    // 테플론 반사 모델 (/veto/surface/wrapModel analytic|table, WrapReflectanceTable)
+    void SetWrapModel(const G4String& model);
+    void LoadWrapTable(const G4String& fileName);
+    void WriteWrapTable(const G4String& fileName);
+    void BenchmarkWrapTable(G4int nReflections);
+
+    // 신틸/글루 형상 모드 (/veto/geometry/mode, /run/initialize 전)
+    //  boolean : 신틸 = box - groove, glue = box - 파이버 원통 (G4SubtractionSolid)
+    //  nested  : box 만 사용한 mother/daughter 중첩 (파이버 2 조각)
+    enum GeometryMode { kBoolean = 0, kNested };
+    void SetGeometryMode(const G4String& mode);
+
+    // 테플론 포장 (/veto/geometry/wrapping)
+    //  slabs   : 10 µm 폴리에틸렌 판 5장 + skin surface
+    //  surface : 신틸 경계에 같은 groundfrontpainted 0.98 표면만 (nested 모드 필요)
+    enum WrappingMode { kSlabWrap = 0, kSurfaceWrap };
+    void SetWrappingMode(const G4String& mode);
+    // 무작위 광선 navigation / 신틸 solid 호출 비용 측정 (/veto/geometry/benchmark)
+    void BenchmarkNavigation(G4int nRays);
+
+    // 세그먼트 배열 (/veto/array/..., /run/initialize 전에 설정)
+    G4int GetNumberOfColumns() const { return fNColumns; }
+    G4int GetNumberOfLayers() const { return fNLayers; }
+    G4int GetNumberOfSegments() const { return fNColumns*fNLayers; }
+    // copy number = layer*columns + column → 신틸 중심 (월드 좌표)
+    G4ThreeVector GetSegmentPosition(G4int copyNo) const;
+    G4ThreeVector GetScintSize() const { return G4ThreeVector(fScintX, fScintY, fScintZ); }
+    // 세그먼트 envelope 배열 전체의 bounding box (월드 좌표, 코스믹 생성기 조준용)
+    void GetArrayBounds(G4ThreeVector& pMin, G4ThreeVector& pMax) const;
+    // 채널(= copy number) 의 SiPM 중심 (월드 좌표)
+    G4ThreeVector GetSiPMPosition(G4int copyNo) const;
+    // /veto/array/writeChannelMap: channel layer column x y z (mm)
+    void WriteChannelMap(const G4String& fileName);
+
+    // 설계 스캔 파라미터 (ParameterScan).
+    //  형상 값은 서로 얽혀 있으므로 (groove ↔ 파이버 반지름) 한꺼번에 검사 후 설정,
+    //  하나라도 범위 밖이면 아무것도 바꾸지 않고 false.
+    G4bool SetFiberDesign(G4double groove, G4double radius, G4double fiberZ, G4double coupling);
+    G4double GetGrooveSize() const { return fGrooveSize; }
+    G4double GetFiberRadius() const { return fFiberCladRadius; }
+    G4double GetFiberZCenter() const { return fFiberZCenter; }
+    G4double GetCouplingThickness() const { return fCouplingThickness; }
+    G4double GetFiberLength() const { return fFiberLength; }
+    G4double GetFiberCoreRadius() const;
+    void   SetWrapReflectivity(G4double r);
 
 private:
-    G4LogicalVolume* fScintillatorLV; // Logical volume for scintillator
+    void DefineCommands();
+    void DefineMaterials();
+    G4double GetEnvelopeHalfX() const;
+    G4double GetPitchX() const;
+    G4double GetPitchY() const;
+
+    G4LogicalVolume* fScintillatorLV = nullptr; // Logical volume for scintillator
+    G4LogicalVolume* fSegmentLV = nullptr;      // 세그먼트 한 개를 담는 envelope (한 번만 생성)
+    std::vector<G4String> fSiPMLVNames;         // SD 를 붙일 SiPM LV ("SiPMLogic"+suffix)
+    G4GenericMessenger* fFiberMessenger = nullptr;
+    G4GenericMessenger* fScintMessenger = nullptr;
+    G4GenericMessenger* fArrayMessenger = nullptr;
+    G4GenericMessenger* fSurfaceMessenger = nullptr;
+    G4GenericMessenger* fGeometryMessenger = nullptr;
+    GeometryMode fGeometryMode = kBoolean;
+    WrappingMode fWrappingMode = kSlabWrap;
+    G4bool fWrapTable = false;                        // 테플론 반사를 lookup 테이블로
+    G4OpticalSurface* fTeflonSurface = nullptr;       // 레지스트리 공유 표면
+    std::vector<G4double> fPhotonEnergies;            // 광학 물성 에너지 격자
+
+    // 세그먼트 치수
+    G4double fScintX, fScintY, fScintZ;
+    G4double fGrooveSize, fFiberLength, fFiberZCenter, fFiberCladRadius;
+    G4double fWrapThickness, fWrapReflectivity;
+    G4double fCouplingThickness, fSiPMSize, fSiPMThickness;
+
+    // 배열 배치: 열(column)은 Y 방향, 층(layer)은 X 방향
+    G4int    fNColumns, fNLayers;
+    G4double fPitchX, fPitchY;    // 0 이면 envelope 크기에 맞춤
+    G4bool   fCheckOverlaps;
 };
 
 #endif
-
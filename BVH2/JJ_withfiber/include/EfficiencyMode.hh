@@ -0,0 +1,45 @@
+#ifndef EFFICIENCYMODE_HH
+#define EFFICIENCYMODE_HH
+
+#include "globals.hh"
+
+class G4GenericMessenger;
+
+// ----------------------------------------------------------------------
+// 효율 런: npe 가 문턱을 넘으면 이벤트의 남은 광학 광자 추적 중단
+//  veto 효율은 npe >= threshold 여부만 필요 → 문턱을 넘은 뒤의 광자 추적은 낭비.
+//  SiPMSensitiveDetector 가 검출 npe 가 threshold 에 도달하면 이벤트를 표시하고
+//  스택을 ReClassify → StackingAction 이 대기 중/새 광학 광자를 fKill.
+//  하전 입자 추적은 그대로 (에너지 침적 불변), npe 는 문턱 근처에서 잘림.
+//   off      : 사용 안 함
+//   on       : 문턱 도달 시 광자 중단
+//   validate : 중단 없이 표시만 → 문턱 뒤 CPU (= on 모드에서 절약될 시간) 측정
+//  결과: hOverThreshold (이벤트당 0/1), 요약에 효율과 이벤트당 CPU/절약 CPU.
+//
+//  /veto/efficiency/threshold 2
+//  /veto/efficiency/mode on
+//  scripts/compare_early_stop.sh 로 off/validate/on 효율·CPU 비교
+// ----------------------------------------------------------------------
+class EfficiencyMode {
+public:
+    enum Mode { kOff = 0, kOn, kValidate };
+
+    EfficiencyMode();
+    ~EfficiencyMode();
+
+    static G4bool IsActive() { return fMode != kOff; }
+    static G4bool AbortsPhotons() { return fMode == kOn; }
+    static Mode   GetMode() { return fMode; }
+    static G4int  GetThreshold() { return fThreshold; }
+
+private:
+    void DefineCommands();
+    void SetMode(const G4String& mode);
+
+    G4GenericMessenger* fMessenger = nullptr;
+
+    static Mode  fMode;
+    static G4int fThreshold;
+};
+
+#endif
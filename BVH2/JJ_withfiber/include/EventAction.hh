@@ -3,9 +3,14 @@
 
 #include "G4UserEventAction.hh"
 #include "globals.hh"
+#include "PhotonBatchEngine.hh"
+#include "PhotonTrackInformation.hh"
+#include "PhaseSpace.hh"
+#include "EventLibrary.hh"
 #include <vector>
 
 class RunAction;
+class G4Track;
 
 class EventAction : public G4UserEventAction
 {
@@ -16,19 +21,70 @@ class EventAction : public G4UserEventAction
     virtual void BeginOfEventAction(const G4Event*);
     virtual void EndOfEventAction(const G4Event*);
 
-    void AddPhoton();                       // 포톤 1개 추가
+    // 포톤 1개 추가 (scintOrigin: 신틸레이션 광자에서 온 검출 → 광량 스캔 thinning 대상)
+    void AddPhoton(G4bool scintOrigin = false);
     void AddEnergyDeposit(G4double energy); // 에너지 누적
     void AddWavelength(G4double wavelength);// 파장 기록
+    void AddHitTime(G4double time);         // 검출 시각 기록
+    // 채널별 검출 (wavelength <= 0 이면 파장 통계 제외: 응답 테이블 모델)
+    void AddChannelHit(G4int channel, G4double time, G4double wavelength);
+    void AddGenstep(const PhotonBatchEngine::Genstep& gs); // 배치 엔진용 genstep
+    void AddPhotonPath(const PhotonTrackInformation& info); // 검출 광자 경로 (재가중용)
+    G4bool RecordsPhotonPaths() const;
+    // 광량 스캔: 광학 광자의 기원 표시 (TrackingAction, 추적 시작)
+    //  신틸레이션 = 예, Cerenkov / 1차 = 아니오, WLS·fast-sim 재방출 = 부모를 따름
+    void MarkPhotonOrigin(const G4Track* track);
+    G4bool IsScintillationPhoton(G4int trackID) const {
+        return trackID > 0 && trackID < G4int(fScintOrigin.size()) && fScintOrigin[trackID];
+    }
+    // sky 모드: 이 이벤트가 대표하는 계수율 (GeneratePrimaries 에서, BeginOfEvent 보다 먼저)
+    void SetPrimaryRate(G4double rate) { fPrimaryRate = rate; }
+    void AddPhaseSpaceRecord(const PhaseSpace::Record& rec) { fPhaseSpace.push_back(rec); }
+    void AddOpticalStep(G4bool newTrack) { fOpticalSteps++; if (newTrack) fOpticalTracks++; }
+    // 효율 모드: npe 가 문턱에 도달 (SiPMSensitiveDetector) → on 이면 남은 광학 광자 중단
+    void MarkOverThreshold();
+    G4bool IsOverThreshold() const { return fOverThreshold; }
+    // 스택 깊이 (스택 + 추적 중 트랙의 미적재 2차 입자) 최대값, photonStack staged 한도 상태
+    void UpdateStackDepth(G4int depth) { if (depth > fPeakStackDepth) fPeakStackDepth = depth; }
+    void SetPhotonStageFull(G4bool full) { fPhotonStageFull = full; }
+    G4bool IsPhotonStageFull() const { return fPhotonStageFull; }
 
     G4int GetPhotonCount() const;
     G4double GetTotalEnergyDeposit() const;
     const std::vector<G4double>& GetWavelengths() const { return fWavelengths; }
+    const std::vector<G4double>& GetHitTimes() const { return fHitTimes; }
 
   private:
     G4int fPhotonCount;               // 이 이벤트에서 검출된 photoelectron 개수
     G4double fEnergyDeposit;          // 이벤트 동안 에너지 적산
     RunAction* fRunAction;            // RunAction 포인터
     std::vector<G4double> fWavelengths; // 검출된 광자의 파장 기록
+    std::vector<G4double> fHitTimes;    // 검출 시각 (전역 시간)
+    std::vector<G4double> fThinKeys;    // 광량 스캔용 광자별 균일 난수 키 (신틸레이션 기원만)
+    G4int                 fUnthinned = 0; // 광량과 무관한 검출 (Cerenkov, 응답 테이블 등)
+    std::vector<char>     fScintOrigin;   // 트랙 ID → 신틸레이션 기원 (광량 스캔 중만)
+    std::vector<G4int>    fScanNpe;
+    std::vector<PhotonTrackInformation> fPhotonPaths; // 검출 광자 경로
+    // 채널별 이벤트 데이터: 발화한 채널만 (SoA, 같은 위치 = 같은 채널)
+    std::vector<G4int>    fChannelSlot;       // 채널 → 위치 (-1 = 미발화), 스레드당 한 번 할당
+    std::vector<G4int>    fFiredChannels;
+    std::vector<G4int>    fChannelNpe;
+    std::vector<G4double> fChannelFirstTime;
+    std::vector<G4double> fChannelWlSum, fChannelWlSum2;
+    std::vector<G4int>    fChannelWlN;
+    std::vector<PhaseSpace::Record> fPhaseSpace; // 이 이벤트의 phase-space 레코드
+    std::vector<EventLibrary::Hit>  fLibraryHits; // 이벤트 라이브러리용 (채널, 시각)
+    G4double fPrimaryRate = 0.;        // 0 = 가중치 없는 소스
+    G4int fOpticalSteps = 0;           // 광학 광자 스텝 수 (navigation 비용 지표)
+    G4int fOpticalTracks = 0;
+    G4bool   fOverThreshold = false;   // 이 이벤트가 효율 문턱을 넘었는지
+    G4double fEventCpuStart = 0.;      // 스레드 CPU (초)
+    G4double fThresholdCpu = 0.;       // 문턱 도달 시점의 스레드 CPU
+    G4int    fPeakStackDepth = 0;
+    G4bool   fPhotonStageFull = false;  // waiting 광자가 한도 → 하전 트랙도 waiting 으로
+
+    PhotonBatchEngine fPhotonEngine;                 // 배치 광자 전파 엔진
+    std::vector<PhotonBatchEngine::Arrival> fArrivals;
 };
 
 #endif
@@ -0,0 +1,66 @@
+#ifndef EVENTLIBRARY_HH
+#define EVENTLIBRARY_HH
+
+#include "globals.hh"
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+class G4GenericMessenger;
+
+// ----------------------------------------------------------------------
+// 이벤트 라이브러리: 이벤트별 SiPM 검출 광자 (채널, 시각) 목록
+//  고계수율 pile-up 은 이 라이브러리를 tools/PileupOverlay 로 겹쳐서 계산
+//  (이벤트를 Poisson 도착 시각에 샘플 → 읽기 창으로 병합) → 직접 시뮬레이션 불필요.
+//
+//  파일 ("VEL1", little endian):
+//   헤더 32 B : magic, flags, 이벤트 수 (uint64), 색인 위치 (uint64), 채널 수, 예약
+//   이벤트    : EventHeader (8 B: 광자 수, 가중치) + Hit (8 B) × 광자 수 (시각 순)
+//   색인      : 이벤트 시작 위치 (uint64) × 이벤트 수  (런 끝마다 다시 씀)
+//   weight = 1, sky 모드는 이벤트 계수율 Hz (flags 의 kRateWeights)
+//
+//  /veto/library/file ../Histogram/library.bin
+//  /veto/library/record true
+//  /run/beamOn 100000
+//  /veto/library/close
+//  → PileupOverlay library.bin pileup.root --rate 1e6 --window 200
+// ----------------------------------------------------------------------
+class EventLibrary {
+public:
+    struct Hit {
+        uint32_t channel;
+        float    time;               // ns (이벤트 시작 기준 전역 시각)
+    };
+    struct EventHeader {
+        uint32_t nHits;
+        float    weight;
+    };
+    static const uint32_t kRateWeights = 1u;
+
+    EventLibrary();
+    ~EventLibrary();
+
+    static G4bool IsRecording() { return fOut.is_open(); }
+    // EventAction: 이벤트 끝마다 (광자가 없어도 — 도착률 정규화에 필요)
+    static void WriteEvent(std::vector<Hit>& hits, G4double weight, G4bool rateWeighted);
+    // 마스터 RunAction: 색인 + 헤더 갱신
+    static void EndOfRun();
+
+private:
+    void DefineCommands();
+    void SetFile(const G4String& fileName);
+    void SetRecord(G4bool record);
+    void Close();
+
+    G4GenericMessenger* fMessenger = nullptr;
+
+    static std::ofstream         fOut;
+    static G4String              fOutName;
+    static std::vector<uint64_t> fOffsets;   // 이벤트 시작 위치
+    static uint64_t              fEnd;      // 마지막 이벤트 끝 (색인은 여기부터)
+    static uint64_t              fNHits;
+    static uint32_t              fNChannels;
+    static uint32_t              fFlags;
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef FIBERTRANSPORTMODEL_HH
+#define FIBERTRANSPORTMODEL_HH
+
+#include "G4VFastSimulationModel.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+#include <vector>
+
+class G4Material;
+
+// ----------------------------------------------------------------------
+// 파이버 광 수송 fast-simulation 모델 (envelope = FiberCladLV 영역)
+//  - core 안의 광자가 core/clad TIR 조건을 만족하면(포획) 반사를 하나씩
+//    추적하지 않고, 남은 길이에 대한 감쇠/WLS 응답을 테이블로 적용한 뒤
+//    +Z 끝(coupling disk 입구)에 올바른 도달 시간으로 바로 내보낸다.
+//  - 포획되지 않는 광자는 Geant4 가 평소대로 추적한다.
+// ----------------------------------------------------------------------
+class FiberTransportModel : public G4VFastSimulationModel {
+public:
+    FiberTransportModel(const G4String& name, G4Region* envelope);
+    virtual ~FiberTransportModel();
+
+    virtual G4bool IsApplicable(const G4ParticleDefinition& particle) override;
+    virtual G4bool ModelTrigger(const G4FastTrack& fastTrack) override;
+    virtual void   DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep) override;
+
+    // 전역 설정 (마스터 messenger 에서 변경)
+    static void SetEnabled(G4bool on) { fEnabled = on; }
+    static G4bool IsEnabled() { return fEnabled; }
+    static void SetEndReflectivity(G4double r) { fEndReflectivity = r; }
+
+private:
+    void BuildTables();
+    G4int EnergyBin(G4double energy) const;
+    G4bool IsTrapped(const G4ThreeVector& pos, const G4ThreeVector& dir) const;
+
+    static G4bool   fEnabled;
+    static G4double fEndReflectivity; // -Z 끝(테플론) 반사율
+
+    G4bool fTablesBuilt;
+    G4int  fTablesRunID = -1;          // 테이블을 만든 런 (런마다 재생성)
+    G4Material* fCoreMat;
+    G4double fNCore, fNClad, fRCore;
+
+    // 균일 에너지 격자 테이블 (상수 시간 조회)
+    G4double fEmin, fEmax, fDE;
+    std::vector<G4double> fMuTotal;      // 1/Labs + 1/Lwls
+    std::vector<G4double> fWLSFraction;  // (1/Lwls) / μ_total
+    std::vector<G4double> fWLSEmitInvCDF; // 균일 u 격자에서의 재방출 에너지
+    G4double fWLSTime;
+};
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef OPTICALCONFIG_HH
+#define OPTICALCONFIG_HH
+
+#include "globals.hh"
+#include <vector>
+
+class G4Track;
+
+// ----------------------------------------------------------------------
+// 광학 프로세스 실행 중 설정 (/veto/optical/..., PhysicsList 메신저)
+//  전역 스위치는 G4OpticalParameters 와 프로세스 활성화로 적용:
+//   cerenkov / wls on|off, Cerenkov 스텝당 최대 광자 수와 β 변화율,
+//   track-secondaries-first (Cerenkov + 신틸레이션)
+//  재질/볼륨별 스위치는 StackingAction 에서: 목록의 재질 이름 또는
+//  LV 이름 접두어가 생성 위치와 맞으면 그 프로세스의 광자를 스택 전에 제거.
+//  photonStack waiting 이면 광학 광자를 하전 입자가 모두 끝난 뒤 추적.
+//  photonStack staged 면 하전 입자 먼저 + 광자는 waiting 스택에 최대 photonBatch 개:
+//   (스택 전체 urgent + waiting + 추적 중 트랙의 미적재 2차 입자) 가 한도에 닿으면 SteppingAction 이
+//   하전 트랙을 suspend → waiting 으로 보내 대기 광자부터 처리 (이벤트 최대 스택 깊이 제한).
+//
+//  /veto/optical/cerenkov false
+//  /veto/optical/killCerenkovIn G4_AIR OpticalGlue
+//  /veto/optical/killWLSIn FiberCladOutLV
+//  /veto/optical/photonStack staged
+//  /veto/optical/photonBatch 5000
+// ----------------------------------------------------------------------
+class OpticalConfig {
+public:
+    // 마스터에서만 호출 (런 사이)
+    static void SetCerenkov(G4bool on);
+    static void SetWLS(G4bool on);
+    static void SetCerenkovMaxPhotons(G4int n);
+    static void SetCerenkovMaxBetaChange(G4double percent);
+    static void SetTrackSecondariesFirst(G4bool on);
+    static void SetKillCerenkovIn(const G4String& names);
+    static void SetKillWLSIn(const G4String& names);
+    static void SetPhotonStack(const G4String& stack);   // urgent | waiting | staged
+    static void SetPhotonBatchLimit(G4int n) { fPhotonBatchLimit = (n > 0) ? n : 1; }
+
+    static G4bool PhotonsWaiting() { return fPhotonsWaiting; }   // waiting 또는 staged
+    static G4bool PhotonsStaged() { return fPhotonsStaged; }
+    static G4int  GetPhotonBatchLimit() { return fPhotonBatchLimit; }
+    // 새 광학 광자를 생성 위치 규칙으로 버릴지 (StackingAction)
+    static G4bool IsKilled(const G4Track* track);
+
+    static void Report();
+
+private:
+    static void SetProcess(const G4String& name, G4bool on);
+    static G4bool Matches(const std::vector<G4String>& names, const G4Track* track);
+
+    static std::vector<G4String> fKillCerenkovIn;
+    static std::vector<G4String> fKillWLSIn;
+    static G4bool fPhotonsWaiting;
+    static G4bool fPhotonsStaged;
+    static G4int  fPhotonBatchLimit;
+};
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef OPTICALSURFACEREGISTRY_HH
+#define OPTICALSURFACEREGISTRY_HH
+
+#include "G4OpticalSurface.hh"
+#include "globals.hh"
+
+#include <map>
+#include <tuple>
+#include <vector>
+
+class G4LogicalVolume;
+class G4VPhysicalVolume;
+class G4MaterialPropertiesTable;
+
+// ----------------------------------------------------------------------
+// 광학 표면 레지스트리
+//  - (type, model, finish, MPT) 가 같은 G4OpticalSurface 는 하나만 생성
+//  - 상수 물성 MPT (예: REFLECTIVITY 0.98) 도 값별로 하나만 생성
+//  - skin surface 는 LV 당 하나, border surface 는 실제로 효과가 있는 것만:
+//    MPT 없는 polished dielectric_dielectric 은 표면이 없을 때의 Fresnel
+//    처리와 같으므로 등록하지 않는다.
+//  세그먼트 LV 를 공유(envelope 배치)하므로 표면 테이블 크기는 세그먼트
+//  수와 무관 → G4OpBoundaryProcess 의 표면 조회 비용이 일정.
+//  (예외: surface 포장의 envelope 경계 border 는 세그먼트당 4 개, 조회는 map 이라 log N)
+//
+//  경계 통과 비용: scripts/bench_surface.sh (고정 시드 광자 런, macros/surface_benchmark.mac)
+// ----------------------------------------------------------------------
+class OpticalSurfaceRegistry {
+public:
+    static OpticalSurfaceRegistry* Instance();
+
+    G4MaterialPropertiesTable* GetConstantPropertyTable(const G4String& property, G4double value,
+                                                        const std::vector<G4double>& energies);
+
+    G4OpticalSurface* GetSurface(const G4String& name, G4SurfaceType type,
+                                 G4OpticalSurfaceModel model, G4OpticalSurfaceFinish finish,
+                                 G4MaterialPropertiesTable* mpt = nullptr);
+
+    // 이미 등록된 LV / PV 쌍, 효과 없는 표면은 건너뜀 (생성 여부 반환)
+    G4bool AddSkinSurface(const G4String& name, G4LogicalVolume* lv, G4OpticalSurface* surface);
+    G4bool AddBorderSurface(const G4String& name, G4VPhysicalVolume* pv1, G4VPhysicalVolume* pv2,
+                            G4OpticalSurface* surface);
+
+    // 형상 재구성 전 (Construct 시작): 이전 표면은 Geant4 표면 테이블과 함께 정리됨
+    void Clear();
+
+    void Report() const;
+
+private:
+    OpticalSurfaceRegistry();
+    ~OpticalSurfaceRegistry();
+
+    using SurfaceKey = std::tuple<G4int, G4int, G4int, const G4MaterialPropertiesTable*>;
+    using TableKey   = std::tuple<G4String, G4double, std::size_t, G4double, G4double>;
+
+    std::map<SurfaceKey, G4OpticalSurface*> fSurfaces;
+    std::map<TableKey, G4MaterialPropertiesTable*> fTables;
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef PARAMETERSCAN_HH
+#define PARAMETERSCAN_HH
+
+#include "globals.hh"
+#include <map>
+#include <vector>
+
+class G4GenericMessenger;
+class DetectorConstruction;
+
+// ----------------------------------------------------------------------
+// 한 프로세스 안의 설계 파라미터 스캔 (마스터 전용)
+//  파라미터 파일의 점마다 바뀐 것만 다시 만든다.
+//   - 형상 (groove, fiberRadius, fiberZ, coupling): 형상만 재구성
+//     (재질이 같으므로 material-cuts couple / 물리 테이블 재사용)
+//   - 광학 물성 (yield, reflectivity): MPT 값만 교체, 형상 유지
+//  결과는 한 ROOT 파일의 run<ID> 디렉토리에 (TNamed "parameters" 포함).
+//
+//  파일 형식: 첫 줄 = 파라미터 이름, 이후 한 줄에 한 점 (# 주석)
+//    groove  fiberRadius  fiberZ  coupling  yield   reflectivity
+//    1.2     0.5          20      0.1       10000   0.98
+//   (길이 mm, yield 1/MeV, reflectivity 0-1; 없는 열은 현재 값 유지)
+//
+//  /veto/scan/events 1000
+//  /veto/scan/run scan_points.txt
+// ----------------------------------------------------------------------
+class ParameterScan {
+public:
+    ParameterScan();
+    ~ParameterScan();
+
+    void Run(const G4String& fileName);
+
+    // RunAction 이 런 디렉토리에 기록 (스캔 밖에서는 빈 문자열)
+    static const G4String& GetPointLabel() { return fPointLabel; }
+
+private:
+    void DefineCommands();
+    // 점 하나 적용 → 형상을 다시 만들어야 하면 true, 잘못된 값이면 ok = false (아무것도 적용 안 함)
+    G4bool Apply(DetectorConstruction* detector, const std::map<G4String, G4double>& point, G4bool& ok);
+
+    G4GenericMessenger* fMessenger = nullptr;
+    G4int fEventsPerPoint = 1000;
+    std::map<G4String, G4double> fCurrent;   // 마지막으로 적용한 광학 값 (형상은 검출기에서 읽음)
+
+    static G4String fPointLabel;
+};
+
+#endif
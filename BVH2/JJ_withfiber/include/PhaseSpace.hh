@@ -0,0 +1,92 @@
+#ifndef PHASESPACE_HH
+#define PHASESPACE_HH
+
+#include "globals.hh"
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+class G4GenericMessenger;
+class G4Step;
+
+// ----------------------------------------------------------------------
+// Phase-space 기록 / 재생
+//  기록: 평면 x = planeX 를 지나거나 (plane) 세그먼트 envelope 에 들어가는 (envelope)
+//   입자를 이진 파일에 쓴다. 광학 광자는 제외. killRecorded 면 기록 후 추적 종료
+//   → 상류 수송 (콜리메이터, 공기) 은 한 번만 계산.
+//  재생: 파일을 mmap 으로 읽고 /veto/gun/mode replay 가 이벤트마다 원래
+//   이벤트 하나 (같은 event 번호의 연속 레코드) 를 그대로 주입.
+//
+//  파일: 헤더 16 B ("VPS1", flags, 원본 이벤트 수) + Record (44 B) 배열
+//   weight = 트랙 가중치 (primary vertex 가중치를 물려받음 → sky 모드는 계수율 Hz,
+//            flags 의 kRateWeights). 이벤트 가중치를 다시 곱하지 않음
+//
+//  /veto/phasespace/record plane | envelope | off
+//  /veto/phasespace/planeX -50 mm
+//  /veto/phasespace/file ps.bin          (기록 파일, record 전에)
+//  /veto/phasespace/killRecorded true
+//  /veto/phasespace/replay ps.bin        + /veto/gun/mode replay
+// ----------------------------------------------------------------------
+class PhaseSpace {
+public:
+    struct Record {
+        int32_t event;               // 원본 이벤트 번호 (재생 묶음 단위)
+        int32_t pdg;
+        float   x, y, z;             // mm (월드)
+        float   dx, dy, dz;
+        float   ekin;                // MeV
+        float   time;                // ns
+        float   weight;
+    };
+    enum Mode { kOff = 0, kPlane, kEnvelope };
+    static const uint32_t kRateWeights = 1u;
+
+    PhaseSpace();
+    ~PhaseSpace();
+
+    // SteppingAction: 기록 조건이면 rec 를 채우고 true
+    static G4bool IsRecording() { return fMode != kOff && fOut.is_open(); }
+    static G4bool KillsRecorded() { return fKillRecorded; }
+    static G4bool Check(const G4Step* step, Record& rec);
+    // EventAction: 이벤트 끝마다 (레코드가 없어도 원본 이벤트 수를 세기 위해)
+    static void WriteEvent(G4int eventID, std::vector<Record>& records, G4bool rateWeighted);
+    // 마스터 RunAction: 헤더의 원본 이벤트 수 갱신 + 요약
+    static void EndOfRun();
+
+    // 재생 (mmap, 읽기 전용이라 스레드 공유)
+    static G4bool IsReplayLoaded() { return fMapped != nullptr; }
+    static std::size_t GetNumberOfReplayEvents() { return fGroups.empty() ? 0 : fGroups.size() - 1; }
+    // 재생 이벤트 i (원본 이벤트 수를 넘으면 순환)
+    static void GetReplayEvent(G4int i, const Record*& begin, const Record*& end);
+    // 재생 가중치 배율: 원본 이벤트 수 대비 (재생 평균 = 원본 런 평균)
+    static G4double GetReplayWeightScale() { return fReplayScale; }
+    static G4bool ReplayHasRates() { return fReplayFlags & kRateWeights; }
+
+private:
+    void DefineCommands();
+    void SetMode(const G4String& mode);
+    void SetFile(const G4String& fileName);
+    void Replay(const G4String& fileName);
+    void Close();
+    static void Unmap();
+
+    G4GenericMessenger* fMessenger = nullptr;
+
+    static Mode          fMode;
+    static G4double      fPlaneX;
+    static G4bool        fKillRecorded;
+    static std::ofstream fOut;
+    static G4String      fOutName;
+    static uint64_t      fNEvents;
+    static uint64_t      fNRecords;
+    static uint32_t      fFlags;
+
+    static void*          fMapped;
+    static std::size_t    fMappedSize;
+    static const Record*  fRecords;
+    static std::vector<std::size_t> fGroups;   // 묶음 시작 인덱스 (+ 끝)
+    static G4double       fReplayScale;
+    static uint32_t       fReplayFlags;
+};
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef PHOTONBATCHENGINE_HH
+#define PHOTONBATCHENGINE_HH
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include <vector>
+
+// ----------------------------------------------------------------------
+// CPU 배치(SoA) 광학 광자 전파 엔진
+//  - G4Scintillation 이 스택에 광자를 올리는 대신, 스텝 단위 "genstep"
+//    (위치, 시간, 광자 수)만 모아 두었다가 이벤트 끝에 한꺼번에 전파한다.
+//  - 기하는 세그먼트 한 개(바 로컬 좌표계)를 해석적으로 기술:
+//    신틸 박스 - groove, groove 안의 glue, 원통형 clad/core 파이버,
+//    +Z 끝의 coupling disk → SiPM.
+//  - 광학: Fresnel/TIR(polished), 벌크 흡수, 파이버 WLS,
+//    테플론(groundfrontpainted) Lambertian 반사.
+// ----------------------------------------------------------------------
+class PhotonBatchEngine {
+public:
+    // 엔진 동작 모드 (전역, 마스터에서만 변경)
+    enum Mode {
+        kGeant4 = 0,   // 기존 Geant4 광학 추적만 사용
+        kBatched,      // 신틸 광자는 엔진으로만 전파 (스택 비활성)
+        kValidate      // Geant4 추적 + 엔진 동시 실행 (hNpe vs hNpeBatched)
+    };
+
+    // 스텝 하나에서 생성된 신틸레이션 광자 묶음 (세그먼트 로컬 좌표)
+    struct Genstep {
+        G4ThreeVector x0, x1;   // pre/post 위치
+        G4double      t0, t1;   // pre/post 전역 시간
+        G4int         nPhotons;
+        G4int         segment;  // 신틸 PV copy number
+    };
+
+    // SiPM 에 도달한 광자 (PDE 적용 전)
+    struct Arrival {
+        G4double energy;
+        G4double time;
+        G4int    segment;
+    };
+
+    PhotonBatchEngine();
+    ~PhotonBatchEngine();
+
+    static void SetMode(Mode mode);
+    static Mode GetMode() { return fMode; }
+    static G4bool CollectsGensteps() { return fMode != kGeant4; }
+
+    // 배치 크기 (SoA 버퍼 길이)
+    static void SetBatchSize(G4int n) { fBatchSize = (n > 0) ? n : 1; }
+
+    // DetectorConstruction 치수와 재질/표면 MPT 상수를 읽어 온다 (런마다 첫 Propagate 시 자동 호출)
+    void Initialize();
+
+    void AddGenstep(const Genstep& gs) { fGensteps.push_back(gs); }
+    void Clear() { fGensteps.clear(); }
+    std::size_t GetNumberOfGensteps() const { return fGensteps.size(); }
+
+    // 쌓인 genstep 을 모두 전파하고 SiPM 도달 광자를 arrivals 에 추가
+    void Propagate(std::vector<Arrival>& arrivals);
+    // 마지막 Propagate 의 전파 광자 수 / 상호작용 한도에서 강제 종료된 광자 수
+    G4int GetNumberOfPropagated() const { return fNPropagated; }
+    G4int GetNumberOfTruncated() const { return fNTruncated; }
+
+private:
+    // 영역 코드
+    enum Region { kScint = 0, kGlue = 1, kDead = 2 };
+
+    // SoA 광자 배치
+    struct Batch {
+        std::vector<G4double> x, y, z, dx, dy, dz, t, e, dist;
+        std::vector<G4int>    region, face, segment;
+        void Resize(std::size_t n);
+    };
+
+    std::size_t FillBatch(std::size_t& gsIndex, G4int& gsOffset);
+    std::size_t Compact(std::size_t n);
+    void ComputeDistances(std::size_t n);
+    void HandleInteractions(std::size_t n, std::vector<Arrival>& arrivals);
+    void HandleFiber(std::size_t i, std::vector<Arrival>& arrivals);
+
+    G4double SampleTable(const std::vector<G4double>& cdf,
+                         const std::vector<G4double>& xs) const;
+    G4double Interpolate(const std::vector<G4double>& xs,
+                         const std::vector<G4double>& ys, G4double x) const;
+    G4double Fresnel(G4double n1, G4double n2, G4double cosI) const;
+    void LambertianAbout(std::size_t i, G4double nx, G4double ny, G4double nz);
+    G4bool RefractOrReflect(std::size_t i, G4double n1, G4double n2,
+                            G4double nx, G4double ny, G4double nz);
+
+    static Mode  fMode;
+    static G4int fBatchSize;
+
+    G4bool fInitialized;
+    G4int  fRunID;                   // 마지막으로 Initialize 한 런
+    std::vector<Genstep> fGensteps;
+    Batch fBatch;
+    G4int fNPropagated = 0;
+    G4int fNTruncated = 0;
+
+    // --- 기하 (바 로컬, DetectorConstruction 에서 읽음; 생성자 값은 기본 치수) ---
+    G4double fHalfX, fHalfY, fHalfZ;
+    G4double fGrooveXmin, fGrooveHalfY;
+    G4double fFiberX, fRClad, fRCore, fFiberZmin, fFiberZmax, fCoupT;
+
+    // --- 광학 상수 ---
+    G4double fNScint, fNGlue, fNClad, fNCore, fNAir, fNSi;
+    G4double fAbsScint, fAbsGlue, fAbsClad, fAbsCore;
+    G4double fReflectivity;
+    G4double fRiseTime, fDecayTime, fWLSTime;
+
+    // 스펙트럼 테이블 (광자 에너지 오름차순)
+    std::vector<G4double> fEnergies;
+    std::vector<G4double> fScintCDF;
+    std::vector<G4double> fWLSEmitCDF;
+    std::vector<G4double> fWLSAbs;
+};
+
+#endif
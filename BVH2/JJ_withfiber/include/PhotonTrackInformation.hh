@@ -0,0 +1,40 @@
+#ifndef PHOTONTRACKINFORMATION_HH
+#define PHOTONTRACKINFORMATION_HH
+
+#include "G4VUserTrackInformation.hh"
+#include "globals.hh"
+
+class G4Material;
+
+// ----------------------------------------------------------------------
+// 광자별 광학 이력 (오프라인 재가중용)
+//  - 재질별 광학 깊이 tau = Σ L / ABSLENGTH(E)  (WLS 전후 에너지 반영)
+//  - 테플론(groundfrontpainted) Lambertian 반사 횟수
+//  WLS 재방출 광자는 부모 이력을 그대로 이어받는다 (TrackingAction).
+//  흡수 길이를 s 배로 바꾸면 검출 광자 가중치는 exp(-tau (1/s - 1)),
+//  반사율 R → R' 이면 (R'/R)^nRefl.
+// ----------------------------------------------------------------------
+class PhotonTrackInformation : public G4VUserTrackInformation {
+public:
+    enum Medium { kScint = 0, kCore, kClad, kGlue, kNMedia };
+
+    PhotonTrackInformation();
+    virtual ~PhotonTrackInformation();
+
+    virtual void Print() const override;
+
+    // 재질 이름 → Medium (해당 없으면 -1)
+    static G4int MediumIndex(const G4Material* material);
+
+    void AddOpticalDepth(G4int medium, G4double tau) { fTau[medium] += tau; }
+    void AddReflection() { fNReflections++; }
+
+    G4double GetOpticalDepth(G4int medium) const { return fTau[medium]; }
+    G4int GetNReflections() const { return fNReflections; }
+
+private:
+    G4double fTau[kNMedia];
+    G4int    fNReflections;
+};
+
+#endif
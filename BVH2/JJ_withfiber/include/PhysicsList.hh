@@ -2,12 +2,73 @@
 #define PHYSICSLIST_HH
 
 #include "G4VModularPhysicsList.hh"
+#include "globals.hh"
+
+class G4GenericMessenger;
+class G4UserLimits;
+class G4VPhysicsConstructor;
+
+// ----------------------------------------------------------------------
+// 영역별 production cut (/veto/cuts/..., 마스터 전용)
+//  segment : SegmentRegion (신틸)
+//  fiber   : FiberRegion + ReadoutRegion (글루, 파이버, coupling, SiPM)
+//  passive : PassiveRegion (테플론 판)
+//  world   : 기본 영역 (월드, 세그먼트 envelope 공기)
+//  eMinOutside > 0 이면 신틸 밖 영역에서 그 이하 e± 를 G4UserSpecialCuts 로 정지
+//  (에너지는 그 자리에 deposit). 기본값은 모두 0.01 mm / 0 → 기존 결과와 동일.
+// ----------------------------------------------------------------------
 
 class PhysicsList : public G4VModularPhysicsList {
 public:
     PhysicsList();
     virtual ~PhysicsList();
+
+    // fast-simulation 프로세스는 모델이 켜진 입자에서만 활성 (꺼져 있으면 스텝 비용 없음).
+    //  프로세스 활성화는 스레드별 → RunAction 이 런 시작마다 호출
+    static void ApplyFastSimulationSwitches();
+
+    // /veto/photon/engine geant4|batched|validate
+    void SetPhotonEngine(const G4String& mode);
+    void SetPhotonBatchSize(G4int n);
+
+    // /veto/physics/preset (/run/initialize 전)
+    //  lean  : 광학 + EM (+ fast simulation)
+    //  decay : lean + 붕괴
+    //  full  : decay + 하드론 QGSP_BERT (기본값, 기존 구성)
+    void SetPreset(const G4String& preset);
+
+    virtual void ConstructProcess() override;
+    virtual void SetCuts() override;
+
+private:
+    void DefineOpticalCommands();
+    void SetCerenkov(G4bool on);
+    void SetWLS(G4bool on);
+    void SetCerenkovMaxPhotons(G4int n);
+    void SetCerenkovMaxBetaChange(G4double percent);
+    void SetTrackSecondariesFirst(G4bool on);
+    void SetPhotonStack(const G4String& stack);
+    void SetPhotonBatchLimit(G4int n);
+    void SetKillCerenkovIn(const G4String& list);
+    void SetKillWLSIn(const G4String& list);
+    void PrintOpticalConfig();
+    void SetSegmentCut(G4double cut);
+    void SetFiberCut(G4double cut);
+    void SetPassiveCut(G4double cut);
+    void SetWorldCut(G4double cut);
+    void SetEMinOutside(G4double ekin);
+    void ApplyRegionCuts();
+
+    G4GenericMessenger* fMessenger = nullptr;
+    G4GenericMessenger* fCutsMessenger = nullptr;
+    G4GenericMessenger* fPresetMessenger = nullptr;
+    G4GenericMessenger* fOpticalMessenger = nullptr;
+    G4VPhysicsConstructor* fDecayPhysics = nullptr;
+    G4VPhysicsConstructor* fHadronPhysics = nullptr;
+    G4UserLimits* fOutsideLimits = nullptr;
+
+    G4double fSegmentCut, fFiberCut, fPassiveCut, fWorldCut;
+    G4double fEMinOutside = 0.;
 };
 
 #endif
-
@@ -9,6 +9,9 @@
 
 class G4ParticleGun;
 class G4Event;
+class G4GenericMessenger;
+class BetaSpectrum;
+class CosmicMuonSpectrum;
 
 class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
@@ -18,10 +21,38 @@ class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 
     virtual void GeneratePrimaries(G4Event*);
 
+    // 소스 모드
+    enum SourceMode { kCosmicMuon = 0, kSr90Beta, kCosmicSky, kReplay };
+    void SetMode(const G4String& mode);
+    // beta 모드 동위원소: sr90y90 (영년 평형, 50/50) | sr90 | y90
+    void SetBetaSource(const G4String& source);
+    void ValidateBeta(G4int n);
+
   private:
-    G4double SampleBetaEnergy(G4double Emax);
+    void DefineCommands();
+
+    G4double SampleBetaEnergy();
     G4ThreeVector SampleConeDirection(G4double maxTheta);
+    void GenerateSkyMuon(G4Event* anEvent);
+    void GenerateReplay(G4Event* anEvent);    // PhaseSpace 파일의 원본 이벤트 하나
+    void GenerateBeamScan(G4Event* anEvent);  // BeamScan 격자점 (event ID 로 결정)
     G4ParticleGun* fParticleGun; // <-- 이름 맞추기
+    G4GenericMessenger* fMessenger = nullptr;
+    BetaSpectrum* fSr90Spectrum = nullptr;    // 역 CDF 테이블 (스레드마다 한 번 생성)
+    BetaSpectrum* fY90Spectrum = nullptr;
+    G4double      fSr90Fraction = 0.5;        // Sr-90 붕괴 비율 (나머지 Y-90)
+    CosmicMuonSpectrum* fSkySpectrum = nullptr; // sky 모드 테이블 (설정이 바뀌면 다시 생성)
+    G4double      fSkyEMin;                   // 뮤온 전체 에너지 범위
+    G4double      fSkyEMax;
+    G4double      fSkyMaxZenith;
+
+    SourceMode    fMode;
+    G4bool        fPinned;       // 고정 kinematics 사용 여부
+    G4double      fPinEnergy;
+    G4ThreeVector fPinPosition;
+    G4ThreeVector fPinDirection;
+    G4String      fPinParticle;  // 비어 있으면 모드의 입자 (mu- / e-)
+    G4bool        fPinIsotropic; // 고정 위치에서 등방 방향 (navigation 벤치마크)
 };
 
 #endif
@@ -0,0 +1,18 @@
+#ifndef RESOURCEUSAGE_HH
+#define RESOURCEUSAGE_HH
+
+#include "globals.hh"
+
+// ----------------------------------------------------------------------
+// 프로세스 메모리 사용량 (초기화 / 스캔 벤치마크용)
+//  Linux: /proc/self/status 의 VmRSS, 그 외: getrusage 최대 RSS
+// ----------------------------------------------------------------------
+namespace ResourceUsage {
+    G4double ResidentMemoryMB();
+    // 프로세스 시작 이후 CPU 시간 (user + system, 초)
+    G4double ProcessCpuSeconds();
+    // 호출한 스레드의 CPU 시간 (초, 이벤트 단위 측정용)
+    G4double ThreadCpuSeconds();
+}
+
+#endif
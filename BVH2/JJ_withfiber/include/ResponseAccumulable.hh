@@ -0,0 +1,32 @@
+#ifndef RESPONSEACCUMULABLE_HH
+#define RESPONSEACCUMULABLE_HH
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <vector>
+
+// ----------------------------------------------------------------------
+// 응답 테이블 셀 하나의 런 누적 (ResponseTableBuilder)
+//  이벤트별 npe 와 모든 검출 시각을 스레드마다 모았다가
+//  런 끝에 마스터로 이어 붙인다 → 마스터 RunAction 이 셀로 압축.
+// ----------------------------------------------------------------------
+class ResponseAccumulable : public G4VAccumulable {
+public:
+    explicit ResponseAccumulable(const G4String& name = "response");
+    virtual ~ResponseAccumulable() {}
+
+    void Fill(G4int npe, const std::vector<G4double>& hitTimes);
+
+    virtual void Merge(const G4VAccumulable& other) override;
+    virtual void Reset() override;
+
+    const std::vector<G4int>&    GetNpe() const { return fNpe; }
+    const std::vector<G4double>& GetTimes() const { return fTimes; }
+
+private:
+    std::vector<G4int>    fNpe;
+    std::vector<G4double> fTimes;
+};
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef RESPONSETABLE_HH
+#define RESPONSETABLE_HH
+
+#include "globals.hh"
+#include <cstdint>
+#include <vector>
+
+// ----------------------------------------------------------------------
+// 세그먼트 검출 응답 테이블
+//  격자: 입자(muon/beta) × 에너지 × 입사점(y,z) × 입사각 θ (x-z 평면)
+//  셀마다 npe 분포와 검출 시각 분포를 분위수(quantile)로 압축해 저장
+//  → 표본 추출은 상수 시간 (u → 분위수 보간)
+// ----------------------------------------------------------------------
+class ResponseTable {
+public:
+    enum Particle { kMuon = 0, kBeta = 1, kNParticles = 2 };
+    static const G4int kNQuantiles = 33;  // u = 0, 1/32, ..., 1
+
+    struct Cell {
+        uint32_t nEvents = 0;
+        float    meanNpe = 0.f;
+        uint16_t npeQ[kNQuantiles]  = {};
+        uint16_t timeQ[kNQuantiles] = {};  // 10 ps 단위, 입사 시각 기준
+    };
+
+    // 런 중에는 읽기 전용으로 공유 (마스터에서 생성/로드)
+    static ResponseTable* Instance();
+
+    void SetGrid(const std::vector<G4double>& energies,
+                 const std::vector<G4double>& ys,
+                 const std::vector<G4double>& zs,
+                 const std::vector<G4double>& thetas);
+
+    G4int CellIndex(G4int particle, G4int iE, G4int iY, G4int iZ, G4int iT) const;
+    // 가장 가까운 격자점 셀 (범위 밖이면 가장자리)
+    G4int FindCell(G4int particle, G4double energy, G4double y, G4double z,
+                   G4double theta) const;
+
+    void FillCell(G4int cell, std::vector<G4int>& npe, std::vector<G4double>& times);
+    const Cell& GetCell(G4int cell) const { return fCells[cell]; }
+
+    G4int    SampleNpe(G4int cell) const;
+    G4double SampleTime(G4int cell) const;
+
+    G4bool Write(const G4String& fileName) const;
+    G4bool Read(const G4String& fileName);
+    G4bool IsLoaded() const { return !fCells.empty(); }
+
+    const std::vector<G4double>& GetEnergies() const { return fEnergies; }
+    const std::vector<G4double>& GetYs() const { return fYs; }
+    const std::vector<G4double>& GetZs() const { return fZs; }
+    const std::vector<G4double>& GetThetas() const { return fThetas; }
+
+private:
+    static G4int Nearest(const std::vector<G4double>& axis, G4double v);
+
+    std::vector<G4double> fEnergies, fYs, fZs, fThetas;
+    std::vector<Cell> fCells;
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef RESPONSETABLEBUILDER_HH
+#define RESPONSETABLEBUILDER_HH
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include <vector>
+
+class G4GenericMessenger;
+
+// ----------------------------------------------------------------------
+// 응답 테이블 생성기 (마스터 전용 명령)
+//  셀 하나 = 런 하나. 매크로 루프가 셀마다 /veto/response/cell 로
+//  PrimaryGeneratorAction 의 muon/beta 모드를 고정 kinematics 로 맞추고
+//  /run/beamOn 을 실행한다. 이벤트별 npe 와 검출 시각은 RunAction 의
+//  accumulable 에 모이고, 런 끝에 마스터가 ResponseTable 셀로 압축한다.
+//  (UI 명령 안에서 BeamOn 을 부르지 않음)
+//
+//  /veto/response/energies 1 10 100 1000   (MeV)
+//  /veto/response/ys  -4 -2 0 2 4           (mm)
+//  /veto/response/zs  -60 -30 0 30 60       (mm)
+//  /veto/response/thetas 0 30 60            (deg)
+//  /veto/response/eventsPerCell 200
+//  /veto/response/begin        → alias {responseLastCell}, {responseEvents}
+//  /control/loop ../macros/response_cell.mac cell 0 {responseLastCell}
+//  /veto/response/write table.bin
+//  /veto/response/load  table.bin  +  /veto/response/fastSim true
+// ----------------------------------------------------------------------
+class ResponseTableBuilder {
+public:
+    ResponseTableBuilder();
+    ~ResponseTableBuilder();
+
+    void Begin();
+    void SelectCell(G4int index);
+    void Write(const G4String& fileName);
+    void Load(const G4String& fileName);
+
+    // 셀 런 중인지 (EventAction: 이벤트 결과를 RunAction 에 누적)
+    static G4bool IsCollecting() { return fCollecting; }
+    // 마스터 RunAction 의 런 끝 (스레드 병합 후): 현재 셀 채움
+    static void EndOfRun(std::vector<G4int> npe, std::vector<G4double> times);
+
+private:
+    void DefineCommands();
+    void SetEnergies(const G4String& list);
+    void SetYs(const G4String& list);
+    void SetZs(const G4String& list);
+    void SetThetas(const G4String& list);
+    void SetParticles(const G4String& which);
+    void SetFastSim(G4bool on);
+
+    G4GenericMessenger* fMessenger;
+
+    std::vector<G4double> fEnergies, fYs, fZs, fThetas;
+    std::vector<G4int> fParticles;
+    G4int fEventsPerCell;
+    G4bool fBuilding;              // begin ~ write 사이
+    G4bool fFastSimWasOn;          // begin 이전 fast simulation 상태
+    G4ThreeVector fOrigin;         // 0번 세그먼트 중심
+    G4double fHalfX;               // 신틸 반폭 (입구면 = -X)
+
+    static G4bool fCollecting;
+    static G4int  fCurrentCell;    // ResponseTable 셀 번호
+};
+
+#endif
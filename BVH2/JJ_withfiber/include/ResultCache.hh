@@ -0,0 +1,59 @@
+#ifndef RESULTCACHE_HH
+#define RESULTCACHE_HH
+
+#include "globals.hh"
+#include <cstdint>
+#include <ostream>
+
+class G4GenericMessenger;
+
+// ----------------------------------------------------------------------
+// 설정 해시 기반 결과 캐시 (마스터 전용)
+//  키 = FNV-1a 64 (아래 전체를 텍스트로 직렬화한 것)
+//   - 형상: 월드부터 PV 트리 (이름, copy no, 위치/회전, solid 파라미터, 재질)
+//   - 재질 MPT (모든 property 벡터 / 상수), 광학 표면 (모델/finish/sigma + MPT)
+//   - 물리: physics constructor 목록, G4OpticalParameters, 영역별 production cut
+//   - 지금까지 적용된 UI 명령 (생성기 설정 등; /run/beamOn, /control, /vis, verbose 제외)
+//   - 난수 엔진 상태 (시드), 이벤트 수
+//   - 빌드 식별자 (CMake 의 git describe + 실행 파일 수정 시각)
+//  적중: 캐시의 ROOT 파일을 출력 경로로 복사하고 시뮬레이션 생략. 런 뒤 난수 엔진
+//        상태 (<key>.rng) 복원 + run ID 증가 → 이후 런은 캐시 없는 세션과 같음.
+//  실패: BeamOn 후 출력 파일을 <key>.root 로 저장 (+ <key>.meta: CPU 시간,
+//        <key>.rng: 런 뒤 마스터 난수 엔진 상태).
+//  축출: 캐시 크기가 maxSizeMB 를 넘으면 가장 오래 안 쓴 항목 (LRU, 파일 mtime) 부터.
+//
+//  /veto/cache/dir ../cache
+//  /veto/cache/maxSizeMB 2048
+//  /veto/cache/beamOn 10000     (/run/beamOn 대신)
+//  /veto/cache/stats
+// ----------------------------------------------------------------------
+class ResultCache {
+public:
+    ResultCache();
+    ~ResultCache();
+
+    void BeamOn(G4int nEvents);
+    void PrintStats();
+
+    // 현재 설정의 키 (16 hex)
+    static G4String ComputeKey(G4int nEvents);
+
+private:
+    void DefineCommands();
+    void Evict();
+    static void DescribeGeometry(std::ostream& os);
+    static void DescribeOptics(std::ostream& os);
+    static void DescribePhysics(std::ostream& os);
+    static void DescribeCommands(std::ostream& os);
+
+    G4GenericMessenger* fMessenger = nullptr;
+    G4String fDirectory = "../cache";
+    G4double fMaxSizeMB = 2048.;
+
+    // 이 프로세스의 통계
+    G4int    fHits = 0, fMisses = 0, fStores = 0, fEvictions = 0;
+    G4double fCpuSaved = 0.;     // 적중한 항목의 원래 CPU 시간 합 (초)
+    G4int    fNextRunID = -1;    // 적중으로 건너뛴 런 뒤의 다음 run ID (-1: 런 매니저 기준)
+};
+
+#endif
@@ -3,12 +3,19 @@
 
 #include "G4UserRunAction.hh"
 #include "G4Accumulable.hh"
+#include "ChannelAccumulable.hh"
+#include "ResponseAccumulable.hh"
 #include "globals.hh"
 #include <vector>
 
 // ROOT 클래스 전방 선언
 class TFile;
+class TDirectory;
 class TH1F;
+class TTree;
+class G4GenericMessenger;
+class G4Timer;
+class PhotonTrackInformation;
 
 class RunAction : public G4UserRunAction
 {
@@ -22,20 +29,88 @@ class RunAction : public G4UserRunAction
     // 기존 누적용
     void AddPhotonCount(G4int count);
     void AddEnergyDeposit(G4double energy);
+    void AddOpticalSteps(G4int steps, G4int tracks);
+    // 가중 소스 (sky 모드): 이벤트당 계수율 → 절대 계수율 / 등가 노출 시간
+    void AddPrimaryRate(G4double rate, G4bool detected);
+    // 효율 모드: 문턱 표시, 이벤트 CPU, 문턱 이후 CPU (초, 스레드 CPU)
+    // 이벤트 최대 스택 깊이 (스택 + 미적재 2차 입자)
+    void AddStackDepth(G4int peak);
+    void AddEfficiencyEvent(G4bool overThreshold, G4double cpu, G4double cpuAfterThreshold);
 
     // 새로운 ROOT 기록용
     void FillWavelengths(const std::vector<G4double>& wavelengths);
     void FillNpe(G4int npe);
+    void FillNpeBatched(G4int npe);   // 배치 엔진 검증용
+    void AddBatchedPhotons(G4int propagated, G4int truncated); // 배치 엔진 광자 / 상호작용 한도 종료
+    void FillNpeScan(const std::vector<G4int>& npe); // 광량 스캔 (광량 점마다 하나)
+
+    // 검출 광자 경로 (오프라인 재가중, /veto/output/photonPaths)
+    G4bool RecordsPhotonPaths() const { return fRecordPhotonPaths; }
+    void FillPhotonPaths(G4int npe, const std::vector<PhotonTrackInformation>& paths);
+    // 발화한 채널 하나의 이벤트 결과 (EventAction 이 발화 채널마다 호출)
+    void FillChannel(G4int channel, G4int npe, G4double firstTime,
+                     G4double wlSum, G4double wlSum2, G4int wlN);
+    // 빔 스캔 격자점 하나의 이벤트 결과 (npe = 0 포함)
+    void FillBeamScan(G4int point, G4int npe, G4double firstTime);
+    // 응답 테이블 셀 하나의 이벤트 결과 (/veto/response/cell 런)
+    void FillResponse(G4int npe, const std::vector<G4double>& hitTimes);
+
+    // /veto/output/runDirectories: 런마다 RECREATE 대신 한 파일의 run<ID> 디렉토리
+    void SetRunDirectories(G4bool on);
+    G4bool UsesRunDirectories() const { return fRunDirectories; }
+    const G4String& GetFileName() const { return fFileName; }
 
   private:
+    void WriteChannels();
+    void WriteBeamScan();
+    // 이 RunAction 의 TH1 (마스터/작업 스레드가 같은 순서로 생성)
+    std::vector<TH1F*> Histograms() const;
+
     // Accumulable (기존)
     G4Accumulable<G4int>    fTotalPhotonCount;
     G4Accumulable<G4double> fTotalEnergyDeposit;
 
     // ROOT 출력용
     TFile* rootFile = nullptr;
+    TDirectory* fRunDirectory = nullptr;      // runDirectories 모드의 현재 런
+    G4String fFileName = "../Histogram/sipm_output.root";
+    G4bool fRunDirectories = false;
+    G4bool fFileCreated = false;              // runDirectories 모드에서 이미 RECREATE 했는지
     TH1F*  hNpe = nullptr;         // 이벤트당 photoelectron 수
     TH1F*  hWavelength = nullptr;  // 파장 분포
+    TH1F*  hNpeBatched = nullptr;  // 배치 엔진 npe (검증 모드)
+    std::vector<TH1F*> hNpeScan;   // 광량 스캔 npe (YieldScan 목록 순서)
+    TH1F*  hOverThreshold = nullptr; // 효율 모드: 이벤트당 문턱 도달 여부 (0/1)
+
+    G4Accumulable<G4int> fTotalBatchedCount;
+    G4Accumulable<G4double> fBatchedPhotons;    // 배치 엔진이 전파한 광자
+    G4Accumulable<G4double> fBatchedTruncated;  // 상호작용 한도에서 강제 종료된 광자
+    G4Accumulable<G4double> fOpticalSteps;    // (int 범위 초과 방지)
+    G4Accumulable<G4double> fOpticalTracks;
+    G4Accumulable<G4double> fPrimaryRateSum;   // Σ 이벤트 계수율 (1/시간)
+    G4Accumulable<G4double> fDetectedRateSum;  // npe > 0 인 이벤트만
+    G4Accumulable<G4double> fStackDepthSum;    // Σ 이벤트 최대 스택 깊이
+    G4Accumulable<G4int>    fStackDepthMax;    // 최대 (kMaximum 병합)
+    G4Accumulable<G4int>    fNOverThreshold;   // 효율 모드
+    G4Accumulable<G4double> fEventCpu;         // Σ 이벤트 스레드 CPU (초)
+    G4Accumulable<G4double> fCpuAfterThreshold; // Σ 문턱 이후 CPU (validate: 절약 가능, on: 남은 비용)
+    ChannelAccumulable fChannelSums;          // 채널별 npe/시각/파장 (발화 채널만)
+    ChannelAccumulable fBeamScanSums;         // 빔 스캔 격자점별 (키 = 점 번호)
+    ResponseAccumulable fResponseSums;        // 응답 테이블 현재 셀 (npe, 검출 시각)
+
+    // 멀티스레드: 작업 스레드는 ROOT 파일 없이 메모리 히스토그램만 채우고
+    //  런 끝에 마스터 히스토그램에 더한다 (mutex)
+    static RunAction* fMasterInstance;
+
+    G4GenericMessenger* fMessenger = nullptr;
+    G4double fCpuAtRunStart = 0.;   // 프로세스 CPU (초기화 + 물리 테이블 포함)
+    G4double fRssAtRunStart = 0.;
+    G4Timer* fRunTimer = nullptr;             // 이벤트당 CPU 시간 보고
+    G4bool fRecordPhotonPaths = false;
+    TTree* tPhotonPaths = nullptr;            // 이벤트당 1 entry
+    G4int  fPathNpe = 0;
+    std::vector<float> fPathTau[4];           // PhotonTrackInformation::Medium 순서
+    std::vector<int>   fPathNRefl;
 };
 
 #endif
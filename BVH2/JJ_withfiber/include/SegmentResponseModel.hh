@@ -0,0 +1,33 @@
+#ifndef SEGMENTRESPONSEMODEL_HH
+#define SEGMENTRESPONSEMODEL_HH
+
+#include "G4VFastSimulationModel.hh"
+#include "G4EmCalculator.hh"
+#include "globals.hh"
+
+// ----------------------------------------------------------------------
+// 세그먼트 envelope fast-simulation 모델 (envelope = ScintLV 영역)
+//  1차 하전 입자(μ±, e±)가 신틸 입구면(-X)으로 들어오면 ResponseTable 에서
+//  npe 와 검출 시각을 샘플링해 EventAction 에 기록하고 추적을 생략한다.
+//   - 뮤온: 직선으로 신틸 출구 (groove 벽 포함) 까지 이동 (G4EmCalculator 평균 dE/dx 손실)
+//   - 전자: envelope 안에서 정지 (운동 에너지 전부 deposit)
+// ----------------------------------------------------------------------
+class SegmentResponseModel : public G4VFastSimulationModel {
+public:
+    SegmentResponseModel(const G4String& name, G4Region* envelope);
+    virtual ~SegmentResponseModel();
+
+    virtual G4bool IsApplicable(const G4ParticleDefinition& particle) override;
+    virtual G4bool ModelTrigger(const G4FastTrack& fastTrack) override;
+    virtual void   DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep) override;
+
+    static void SetEnabled(G4bool on) { fEnabled = on; }
+    static G4bool IsEnabled() { return fEnabled; }
+
+private:
+    G4EmCalculator fEmCalculator;   // 뮤온 통과 손실 (스레드별 모델)
+
+    static G4bool fEnabled;
+};
+
+#endif
@@ -12,6 +12,8 @@
 #include <vector>
 #include <string>
 
+class PhotonTrackInformation;
+
 class SiPMSensitiveDetector : public G4VSensitiveDetector {
 public:
     // Constructor and Destructor
@@ -23,6 +25,20 @@ public:
     virtual G4bool ProcessHits(G4Step* step, G4TouchableHistory* history) override;
     virtual void EndOfEvent(G4HCofThisEvent* hce) override;
 
+    // 파장별 PDE (Hamamatsu 데이터 선형 보간)
+    static G4double GetPDE(G4double wavelength_nm);
+
+    // SiPM 에 도달한 광자 하나를 PDE 로 판정하고 EventAction 에 기록
+    // (Geant4 추적과 배치 광자 엔진이 같은 경로를 사용)
+    // pathInfo 가 있으면 재가중용 광자 경로도 기록, channel = 세그먼트 copy number
+    // scintOrigin: 신틸레이션 광자에서 온 검출 (광량 스캔 thinning 대상)
+    static G4bool RecordPhoton(G4double photonEnergy, G4double time,
+                               const PhotonTrackInformation* pathInfo = nullptr,
+                               G4int channel = 0, G4bool scintOrigin = false);
+
+    // 터치러블 history 에서 "Segment" envelope 의 copy number (없으면 0)
+    static G4int ChannelOf(const G4VTouchable* touchable);
+
 private:
     G4int fPhotonCount; // Counter for detected photons
 };
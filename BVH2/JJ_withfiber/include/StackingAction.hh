@@ -0,0 +1,23 @@
+#ifndef STACKINGACTION_HH
+#define STACKINGACTION_HH
+
+#include "G4UserStackingAction.hh"
+#include "globals.hh"
+
+// ----------------------------------------------------------------------
+// 광학 광자 스택 분류 (OpticalConfig)
+//  - 재질/볼륨별로 끈 Cerenkov / WLS 광자는 추적 전에 제거
+//  - photonStack waiting 이면 광학 광자를 waiting 스택으로
+//  - photonStack staged: 한도에서 suspend 된 하전 트랙도 waiting (NewStage 에서 해제)
+//  - 효율 모드 on: 문턱을 넘은 이벤트의 광학 광자는 제거 (waiting → urgent 이동 시 재분류)
+// ----------------------------------------------------------------------
+class StackingAction : public G4UserStackingAction {
+public:
+    StackingAction();
+    virtual ~StackingAction();
+
+    virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* track) override;
+    virtual void NewStage() override;
+};
+
+#endif
@@ -5,6 +5,11 @@
 #include "EventAction.hh"
 #include "G4SystemOfUnits.hh"
 
+class G4Scintillation;
+class G4OpBoundaryProcess;
+class TabulatedBoundaryProcess;
+class G4Material;
+
 class SteppingAction : public G4UserSteppingAction {
 public:
     SteppingAction(EventAction* eventAction); // 수정: EventAction 포인터를 받는 생성자 추가
@@ -14,6 +19,14 @@ public:
 
 private:
     EventAction* fEventAction; // 수정: EventAction 포인터를 저장
+    G4Scintillation* fScintProcess = nullptr; // genstep 수집용 (배치 엔진)
+
+    // 광자 경로 기록 (오프라인 재가중)
+    void RecordPhotonPath(const G4Step* step);
+    G4OpBoundaryProcess* fBoundaryProcess = nullptr;
+    TabulatedBoundaryProcess* fTabulatedBoundary = nullptr;   // 테이블 모드일 때만
+    const G4Material* fLastMaterial = nullptr;
+    G4int fLastMedium = -1;
 };
 
 #endif
@@ -0,0 +1,35 @@
+#ifndef TABULATEDBOUNDARYPROCESS_HH
+#define TABULATEDBOUNDARYPROCESS_HH
+
+#include "G4OpBoundaryProcess.hh"
+
+class G4OpticalSurface;
+
+// ----------------------------------------------------------------------
+// G4OpBoundaryProcess + 테플론 포장 lookup 테이블
+//  경계의 표면이 WrapReflectanceTable 대상(TeflonSurface)이면 반사율과
+//  반사 방향을 테이블에서 샘플링하고, 나머지 경계는 기존 처리 그대로.
+//  /run/initialize 전에 /veto/surface/wrapModel table 을 고른 경우에만
+//  PhysicsList 가 G4OpticalPhysics 의 "OpBoundary" 를 이 프로세스로 교체.
+// ----------------------------------------------------------------------
+class TabulatedBoundaryProcess : public G4OpBoundaryProcess {
+public:
+    TabulatedBoundaryProcess();
+    virtual ~TabulatedBoundaryProcess();
+
+    virtual G4VParticleChange* PostStepDoIt(const G4Track& track, const G4Step& step) override;
+
+    // GetStatus() 는 가상이 아님 → 테이블로 처리한 스텝도 포함한 상태
+    G4OpBoundaryProcessStatus GetLastStatus() const {
+        return fHandled ? fTableStatus : GetStatus();
+    }
+
+private:
+    // G4OpBoundaryProcess 와 같은 순서: border(pre, post) → skin
+    static const G4OpticalSurface* FindSurface(const G4Step& step);
+
+    G4bool fHandled = false;
+    G4OpBoundaryProcessStatus fTableStatus = Undefined;
+};
+
+#endif
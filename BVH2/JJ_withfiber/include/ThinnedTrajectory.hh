@@ -0,0 +1,46 @@
+#ifndef THINNEDTRAJECTORY_HH
+#define THINNEDTRAJECTORY_HH
+
+#include "G4Trajectory.hh"
+#include "G4Allocator.hh"
+
+class G4LogicalVolume;
+
+// ----------------------------------------------------------------------
+// 점 밀도를 줄인 궤적 (광학 광자 표시용, TrajectoryFilter)
+//  시작점 + pointStride 스텝마다 한 점 + 마지막 점만 저장.
+//  target LV 에 들어간 적이 있는지 기록 (volume 필터).
+//  G4Trajectory 의 allocator 는 기반 클래스 크기라 자체 allocator 사용.
+// ----------------------------------------------------------------------
+class ThinnedTrajectory : public G4Trajectory {
+public:
+    ThinnedTrajectory(const G4Track* track, G4int pointStride, const G4LogicalVolume* target);
+    ~ThinnedTrajectory() override = default;
+
+    void AppendStep(const G4Step* step) override;
+    G4bool ReachedTarget() const { return fReachedTarget; }
+
+    inline void* operator new(size_t);
+    inline void  operator delete(void* trajectory);
+
+private:
+    G4int fStride;
+    G4int fNSteps = 0;
+    const G4LogicalVolume* fTarget;
+    G4bool fReachedTarget = false;
+};
+
+extern G4ThreadLocal G4Allocator<ThinnedTrajectory>* thinnedTrajectoryAllocator;
+
+inline void* ThinnedTrajectory::operator new(size_t)
+{
+    if (!thinnedTrajectoryAllocator) thinnedTrajectoryAllocator = new G4Allocator<ThinnedTrajectory>;
+    return static_cast<void*>(thinnedTrajectoryAllocator->MallocSingle());
+}
+
+inline void ThinnedTrajectory::operator delete(void* trajectory)
+{
+    thinnedTrajectoryAllocator->FreeSingle(static_cast<ThinnedTrajectory*>(trajectory));
+}
+
+#endif
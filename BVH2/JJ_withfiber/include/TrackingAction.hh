@@ -0,0 +1,42 @@
+#ifndef TrackingAction_h
+#define TrackingAction_h 1
+
+#include "G4UserTrackingAction.hh"
+#include "globals.hh"
+
+class EventAction;
+class G4LogicalVolume;
+
+// ----------------------------------------------------------------------
+// 광학 광자에 PhotonTrackInformation 부착
+//  - 새 광자(신틸/체렌코프): 빈 이력
+//  - WLS 재방출 광자: 부모 광자 이력 복사
+// 광량 스캔 중이면 광자 기원 (신틸레이션 여부) 을 EventAction 에 표시
+// 광학 광자 궤적 필터 (TrajectoryFilter)
+//  - 저장할 광자만 ThinnedTrajectory, 나머지는 이 트랙 동안 storeTrajectory 0
+//  - detected/volume: 추적 끝에서 조건이 안 맞으면 궤적 폐기
+//    (storeTrajectory 는 다음 트랙 시작에서 복원)
+// ----------------------------------------------------------------------
+class TrackingAction : public G4UserTrackingAction
+{
+  public:
+    TrackingAction(EventAction* eventAction);
+    virtual ~TrackingAction();
+
+    virtual void PreUserTrackingAction(const G4Track* track);
+    virtual void PostUserTrackingAction(const G4Track* track);
+
+  private:
+    void FilterTrajectory(const G4Track* track);
+    void SuppressTrajectory();
+
+    EventAction* fEventAction;
+    G4int fSavedStoreTrajectory = -1;   // 억제 전 storeTrajectory 값 (-1 = 억제 안 함)
+    G4int fEventID = -1;
+    G4int fNStored = 0;                 // 이 이벤트에 저장한 광자 궤적 수
+    G4int fPhotonCountAtStart = 0;      // detected 판정용
+    G4String fTargetName;
+    const G4LogicalVolume* fTargetVolume = nullptr;
+};
+
+#endif
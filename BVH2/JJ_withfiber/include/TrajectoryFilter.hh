@@ -0,0 +1,56 @@
+#ifndef TRAJECTORYFILTER_HH
+#define TRAJECTORYFILTER_HH
+
+#include "globals.hh"
+
+class G4GenericMessenger;
+
+// ----------------------------------------------------------------------
+// 광학 광자 궤적 저장 필터 (/tracking/storeTrajectory 가 켜져 있을 때)
+//  뮤온 이벤트는 광자 궤적이 수만 개 → 메모리/뷰어가 버티지 못함.
+//   all      : 모두 저장 (기존 동작)
+//   sampled  : fraction 비율만 (event/track ID 해시 → 물리 난수열 불변)
+//   detected : SiPM 에서 검출된 광자만 (추적 중 npe 증가로 판정)
+//   volume   : 지정한 LV 에 들어간 광자만
+//   none     : 광자 궤적 저장 안 함
+//  all 외에는 ThinnedTrajectory (pointStride 스텝마다 한 점), 이벤트당 최대 maxPerEvent 개.
+//  하전 입자 궤적은 영향 없음. 판정은 TrackingAction.
+//
+//  /veto/trajectory/photons sampled
+//  /veto/trajectory/fraction 0.01
+//  /veto/trajectory/volume FiberCoreLV
+//  /veto/trajectory/pointStride 10
+//  /veto/trajectory/maxPerEvent 2000
+// ----------------------------------------------------------------------
+class TrajectoryFilter {
+public:
+    enum Mode { kAll = 0, kSampled, kDetected, kVolume, kNone };
+
+    TrajectoryFilter();
+    ~TrajectoryFilter();
+
+    static Mode     GetMode() { return fMode; }
+    static G4bool   IsActive() { return fMode != kAll; }
+    // 판정이 추적 끝 (PostUserTrackingAction) 에서 나는 모드
+    static G4bool   DecidesAtTrackEnd() { return fMode == kDetected || fMode == kVolume; }
+    static G4double GetFraction() { return fFraction; }
+    static const G4String& GetVolumeName() { return fVolumeName; }
+    static G4int    GetPointStride() { return fPointStride; }
+    static G4int    GetMaxPerEvent() { return fMaxPerEvent; }
+    // sampled 모드: (event, track) 별 고정된 [0,1) 값
+    static G4double SampleKey(G4int eventID, G4int trackID);
+
+private:
+    void DefineCommands();
+    void SetMode(const G4String& mode);
+
+    G4GenericMessenger* fMessenger = nullptr;
+
+    static Mode     fMode;
+    static G4double fFraction;
+    static G4String fVolumeName;
+    static G4int    fPointStride;
+    static G4int    fMaxPerEvent;
+};
+
+#endif
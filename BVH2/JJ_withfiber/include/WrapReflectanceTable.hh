@@ -0,0 +1,74 @@
+#ifndef WRAPREFLECTANCETABLE_HH
+#define WRAPREFLECTANCETABLE_HH
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+#include <vector>
+
+class G4OpticalSurface;
+
+// ----------------------------------------------------------------------
+// 테플론 포장 반사 lookup 테이블 (TabulatedBoundaryProcess 에서 사용)
+//  - 반사율 R(E): 균일 에너지 격자 → 인덱스 계산 + 선형 보간
+//  - 반사 방향: 법선 기준 cosθ 역누적분포를 균일 u 격자로 저장
+//    (Lambert: cosθ = √u), φ 는 균일
+//  둘 다 상수 시간 샘플링. 테이블은 groundfrontpainted 표면의 REFLECTIVITY
+//  와 Lambert 분포로 한 번 만들거나 측정값 파일에서 읽는다.
+//
+//  파일 형식 (텍스트, # 주석):
+//    R <광자 에너지 eV> <반사율>
+//    A <cosθ_out> <단위 입체각당 세기>      (Lambert 면 세기 ∝ cosθ)
+//
+//  /veto/surface/wrapModel analytic | table    (table 은 /run/initialize 전에)
+//  /veto/surface/wrapTable measured.txt      (없으면 해석 모델에서 생성)
+//  /veto/surface/writeWrapTable wrap.txt
+//  /veto/surface/wrapBenchmark 10000000
+// ----------------------------------------------------------------------
+class WrapReflectanceTable {
+public:
+    static WrapReflectanceTable* Instance();
+
+    // 해석 모델 표면에서 생성 (REFLECTIVITY + Lambert)
+    void BuildFromSurface(const G4OpticalSurface* surface);
+    G4bool Read(const G4String& fileName);
+    G4bool Write(const G4String& fileName) const;
+
+    G4bool IsLoaded() const { return !fReflectance.empty(); }
+    G4bool IsMeasured() const { return fMeasured; }   // 파일에서 읽음
+    // 테이블 모드 요청 (초기화 전): PhysicsList 가 경계 프로세스를 교체할지
+    void SetRequested(G4bool on) { fRequested = on; }
+    G4bool IsRequested() const { return fRequested; }
+    // 테이블이 대신할 표면 (nullptr = 사용 안 함)
+    void SetTarget(const G4OpticalSurface* surface) { fTarget = surface; }
+    G4bool IsActive() const { return fTarget && IsLoaded(); }
+    G4bool Applies(const G4OpticalSurface* surface) const {
+        return surface && surface == fTarget && IsLoaded();
+    }
+
+    G4double Reflectance(G4double energy) const;
+    // 안쪽 법선 기준 반사 방향
+    G4ThreeVector SampleDirection(const G4ThreeVector& normal) const;
+
+    // 해석 모델(G4BooleanRand + G4LambertianRand) 대비 반사 한 번의 비용
+    void Benchmark(G4int nReflections) const;
+
+private:
+    WrapReflectanceTable() = default;
+
+    void SetReflectance(const std::vector<G4double>& energies, const std::vector<G4double>& values);
+    void SetAngular(const std::vector<G4double>& cosines, const std::vector<G4double>& intensities);
+
+    static const G4int kNEnergy   = 128;
+    static const G4int kNQuantile = 256;
+
+    const G4OpticalSurface* fTarget = nullptr;
+    G4bool fRequested = false;
+    G4bool fMeasured = false;
+    G4double fEmin = 0., fEstep = 1.;
+    std::vector<G4double> fReflectance;    // kNEnergy
+    std::vector<G4double> fCosQuantile;    // kNQuantile + 1
+    // Write 용 원본 입력
+    std::vector<G4double> fInE, fInR, fInCos, fInI;
+};
+
+#endif
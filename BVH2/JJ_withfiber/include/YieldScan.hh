@@ -0,0 +1,41 @@
+#ifndef YIELDSCAN_HH
+#define YIELDSCAN_HH
+
+#include "globals.hh"
+#include <vector>
+
+// ----------------------------------------------------------------------
+// 신틸레이션 광량(SCINTILLATIONYIELD) 단일 패스 스캔
+//  스캔 중에는 EJ212 광량을 목록의 최댓값으로 올려 한 번만 시뮬레이션하고,
+//  신틸레이션 기원 검출 광자마다 균일 난수 키 u 를 붙인다. 광량 Y 에서의 npe 는
+//  u < Y / Ymax 인 광자 수 (binomial thinning → 포아송 통계 보존)
+//  + 광량과 무관한 검출 (Cerenkov, 1차 광자, 응답 테이블 모델) 은 모든 점에 그대로.
+//
+//  /veto/scint/yieldScan 2000 4000 6000 8000 10000   (1/MeV)
+//  /veto/scint/yieldScan                              (해제, 기준 광량 복원)
+// ----------------------------------------------------------------------
+class YieldScan {
+public:
+    // 마스터에서만 호출 (런 사이)
+    static void SetYields(const std::vector<G4double>& yields);
+    // 스캔 밖의 기준 광량 (ParameterScan), 스캔 중이면 해제 후 적용
+    static void SetBaseYield(G4double yield);
+
+    static G4bool IsActive() { return !fYields.empty(); }
+    static const std::vector<G4double>& GetYields() { return fYields; }
+    static G4double GetMaxYield() { return fMaxYield; }
+
+    // 이벤트 끝: 키 목록 (+ thinning 안 하는 검출 수) → 광량별 npe
+    static void Thin(const std::vector<G4double>& keys, G4int unthinned, std::vector<G4int>& npe);
+
+    static const G4double kNominalYield; // DetectorConstruction 기본값
+
+private:
+    static void ApplyYield(G4double yield);
+
+    static std::vector<G4double> fYields;
+    static G4double fMaxYield;
+    static G4double fBaseYield;
+};
+
+#endif
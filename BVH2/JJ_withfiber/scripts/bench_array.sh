@@ -0,0 +1,17 @@
+#!/bin/bash
+# 세그먼트 배열 초기화 벤치마크: N = 1 → 1000 개에서 초기화 시간과 세그먼트당 메모리
+#  사용법: scripts/bench_array.sh [실행 파일 경로]   (build 디렉토리에서 실행)
+EXE=${1:-./SiPM_Scintillator}
+MAC=$(mktemp /tmp/bench_array_XXXX.mac)
+
+for N in 1 10 100 1000; do
+    cat > "$MAC" <<MAC
+/veto/array/columns $N
+/veto/array/checkOverlaps false
+/run/initialize
+MAC
+    echo -n "N=$N  "
+    "$EXE" "$MAC" 2>/dev/null | grep "^\[Array\]"
+done
+
+rm -f "$MAC"
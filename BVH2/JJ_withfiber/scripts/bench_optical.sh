@@ -0,0 +1,62 @@
+#!/bin/bash
+# 광학 프로세스 스위치별 비용, npe 영향, 이벤트 최대 스택 깊이 (기준 = 기본 설정)
+#  한 프로세스에서 /veto/optical/... 만 바꿔 가며 반복, 스위치는 항목마다 기본값으로 복원
+#  사용법: scripts/bench_optical.sh [실행 파일 경로] [이벤트 수] [cosmic|beta]   (build 디렉토리에서 실행)
+EXE=${1:-./SiPM_Scintillator}
+NEV=${2:-1000}
+SRC=${3:-cosmic}
+MAC=$(mktemp /tmp/bench_optical_XXXX.mac)
+
+RESET="/veto/optical/cerenkov true
+/veto/optical/wls true
+/veto/optical/cerenkovMaxPhotons 100
+/veto/optical/cerenkovMaxBetaChange 10
+/veto/optical/trackSecondariesFirst true
+/veto/optical/photonStack urgent
+/veto/optical/photonBatch 5000
+/veto/optical/killCerenkovIn
+/veto/optical/killWLSIn"
+
+#        이름 | 설정 명령 (';' 구분)
+SETTINGS=(
+  "reference|"
+  "noCerenkov|/veto/optical/cerenkov false"
+  "cerenkovOnlyScint|/veto/optical/killCerenkovIn G4_AIR OpticalGlue PMMA_Clad PS_Core G4_POLYETHYLENE"
+  "noCerenkovAir|/veto/optical/killCerenkovIn G4_AIR"
+  "cerenkovMax20|/veto/optical/cerenkovMaxPhotons 20"
+  "noWLSOutside|/veto/optical/killWLSIn FiberCladOutLV FiberCoreOutLV"
+  "noSecFirst|/veto/optical/trackSecondariesFirst false"
+  "photonsWaiting|/veto/optical/photonStack waiting"
+  "photonsStaged|/veto/optical/photonStack staged"
+  "staged1000|/veto/optical/photonStack staged;/veto/optical/photonBatch 1000"
+)
+
+{
+    echo "/veto/gun/mode $SRC"
+    echo "/run/initialize"
+    for S in "${SETTINGS[@]}"; do
+        NAME=${S%%|*}; CMDS=${S#*|}
+        echo "/control/echo \"[OptBench] $NAME\""
+        echo "$RESET"
+        [ -n "$CMDS" ] && echo "$CMDS" | tr ';' '\n'
+        echo "/veto/optical/print"
+        echo "/random/setSeeds 12345 67890"
+        echo "/run/beamOn $NEV"
+    done
+} > "$MAC"
+
+"$EXE" "$MAC" 2>/dev/null | awk '
+    /^\[OptBench\]/   { name = $2 }
+    /^Mean npe/       { mean[name] = $4; err[name] = $6 }
+    /^\[Stack\]/      { depth[name] = $9 }
+    /^\[Resources\]/  { evs[name] = $18; order[n++] = name }
+    END {
+        ref = order[0];
+        printf "%-18s %10s %18s %8s %10s\n", "setting", "events/s", "mean npe", "dev/sig", "max stack";
+        for (i = 0; i < n; i++) {
+            k = order[i];
+            s = sqrt(err[k]^2 + err[ref]^2); d = mean[k] - mean[ref];
+            printf "%-18s %10.1f %10.3f +- %5.3f %8.2f %10d\n", k, evs[k], mean[k], err[k], (s > 0 ? d/s : 0), depth[k];
+        }
+    }'
+rm -f "$MAC"
@@ -0,0 +1,25 @@
+#!/bin/bash
+# 물리 preset 별 비용: 소스 모드(cosmic / beta) 마다 초기화 CPU(물리 테이블 포함), RSS, events/s
+#  preset 은 /run/initialize 전에만 바꿀 수 있으므로 조합마다 새 프로세스
+#  사용법: scripts/bench_physics.sh [실행 파일 경로] [이벤트 수]   (build 디렉토리에서 실행)
+EXE=${1:-./SiPM_Scintillator}
+NEV=${2:-1000}
+MAC=$(mktemp /tmp/bench_physics_XXXX.mac)
+
+printf "%-7s %-6s %10s %9s %10s %12s\n" "source" "preset" "init CPU s" "RSS MB" "events/s" "mean npe"
+for SRC in cosmic beta; do
+    for PRESET in lean decay full; do
+        cat > "$MAC" <<MAC
+/veto/physics/preset $PRESET
+/veto/gun/mode $SRC
+/run/initialize
+/random/setSeeds 12345 67890
+/run/beamOn $NEV
+MAC
+        "$EXE" "$MAC" 2>/dev/null | awk -v s="$SRC" -v p="$PRESET" '
+            /^Mean npe/     { npe = $4 }
+            /^\[Resources\]/ { cpu = $5; rss = $15; evs = $18 }
+            END { printf "%-7s %-6s %10.2f %9.1f %10.1f %12.3f\n", s, p, cpu, rss, evs, npe }'
+    done
+done
+rm -f "$MAC"
@@ -0,0 +1,30 @@
+#!/bin/bash
+# 경계 표면 비용 vs 세그먼트 수: 고정 시드 광자 런 (macros/surface_benchmark.mac), 1 스레드
+#  광자 스텝 = 경계 통과 → 스텝당 CPU 가 표면 조회 비용을 포함
+#  두 번째 실행 파일을 주면 같은 런을 비교 (예: 레지스트리 도입 전 빌드)
+#  사용법: scripts/bench_surface.sh [실행 파일 경로] [비교 실행 파일]   (build 디렉토리에서 실행)
+EXE=${1:-./SiPM_Scintillator}
+REF=$2
+MAC=$(mktemp /tmp/bench_surface_XXXX.mac)
+
+printf "%-6s %-6s %12s %12s %12s %10s\n" "build" "N" "ms/event" "steps/phot" "ns/step" "mean npe"
+for N in 1 11 101 1001; do
+    cat > "$MAC" <<MAC
+/veto/array/columns $N
+/veto/array/checkOverlaps false
+/control/execute ../macros/surface_benchmark.mac
+MAC
+    for B in new ref; do
+        X=$EXE; [ $B = ref ] && X=$REF
+        [ -z "$X" ] && continue
+        "$X" "$MAC" 1 2>/dev/null | awk -v b=$B -v n=$N '
+            /^\[Surface\]/                { print "#", b, "N=" n, $0 }
+            /^Number of events processed/ { nev = $5 }
+            /^Mean npe/                   { npe = $4 }
+            /^Optical steps per photon/   { spp = $5; spe = substr($6, 2) }
+            /^CPU time per event/         { ms = $5 }
+            END { printf "%-6s %-6d %12.4f %12.2f %12.1f %10.3f\n", b, n, ms, spp, (spe > 0 ? ms*1e6/spe : 0), npe }'
+    done
+done
+
+rm -f "$MAC"
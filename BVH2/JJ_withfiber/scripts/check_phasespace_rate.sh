@@ -0,0 +1,47 @@
+#!/bin/bash
+# Phase-space 왕복 검사 (sky 모드): 기록 런과 재생 런의 [Cosmic] 계수율 / 노출 시간
+#  재생 계수율 = 원본 계수율 × (기록된 이벤트 / 원본 이벤트)  (envelope 에 들어간 뮤온만 재생)
+#  재생 이벤트 수 = 기록된 이벤트 수 → 노출 시간이 원본과 같아야 함
+#  사용법: scripts/check_phasespace_rate.sh [실행 파일 경로] [이벤트 수]   (build 디렉토리에서 실행)
+EXE=${1:-./SiPM_Scintillator}
+NEV=${2:-10000}
+DIR=$(mktemp -d /tmp/check_phasespace_XXXX)
+
+cat > "$DIR/record.mac" <<MAC
+/run/initialize
+/veto/phasespace/file $DIR/ps.bin
+/veto/phasespace/killRecorded true
+/veto/phasespace/record envelope
+/veto/gun/mode sky
+/random/setSeeds 12345 67890
+/run/beamOn $NEV
+/veto/phasespace/close
+MAC
+SRC=$("$EXE" "$DIR/record.mac" 2>/dev/null | grep "^\[Cosmic\]")
+
+cat > "$DIR/probe.mac" <<MAC
+/veto/phasespace/replay $DIR/ps.bin
+MAC
+NGROUPS=$("$EXE" "$DIR/probe.mac" 2>/dev/null | awk '/^\[PhaseSpace\] mapped/ { print $6 }')
+
+cat > "$DIR/replay.mac" <<MAC
+/run/initialize
+/veto/phasespace/replay $DIR/ps.bin
+/veto/gun/mode replay
+/run/beamOn $NGROUPS
+MAC
+REP=$("$EXE" "$DIR/replay.mac" 2>/dev/null | grep "^\[Cosmic\]")
+
+echo "source: $SRC"
+echo "replay: $REP"
+awk -v src="$SRC" -v rep="$REP" -v n="$NEV" -v g="$NGROUPS" 'BEGIN {
+    split(src, a, " "); split(rep, b, " ");
+    rs = a[7]; rr = b[7]; es = a[length(a) - 1]; er = b[length(b) - 1];
+    want = rs * g / n;
+    dr = (want > 0) ? rr / want - 1 : 1; de = (es > 0) ? er / es - 1 : 1;
+    printf "recorded %d / %d events\n", g, n;
+    printf "rate   source %.4g Hz x %.4f = %.4g Hz, replay %.4g Hz (%+.2e)\n", rs, g / n, want, rr, dr;
+    printf "exposure source %.4g s, replay %.4g s (%+.2e) -> %s\n", es, er, de,
+           (dr*dr < 1e-6 && de*de < 1e-6) ? "MATCH" : "MISMATCH";
+}'
+rm -rf "$DIR"
@@ -0,0 +1,37 @@
+#!/bin/bash
+# 효율 모드 검증: validate (중단 없음 = 기준) / on 을 같은 시드로 실행해 효율과 CPU/event 비교
+#  validate 의 "CPU after threshold" = on 모드에서 절약될 이벤트당 CPU 추정
+#  효율 차이 (dev/sig) 가 통계 범위 안이면 결과 불변 (시드가 같아도 중단 뒤 난수열이 달라짐)
+#  사용법: scripts/compare_early_stop.sh [실행 파일 경로] [이벤트 수] [문턱]   (build 디렉토리에서 실행)
+EXE=${1:-./SiPM_Scintillator}
+NEV=${2:-2000}
+THR=${3:-2}
+MAC=$(mktemp /tmp/early_stop_XXXX.mac)
+
+echo "/run/initialize" > "$MAC"
+echo "/veto/efficiency/threshold $THR" >> "$MAC"
+for MODE in validate on; do
+    cat >> "$MAC" <<MAC
+/control/echo "[EarlyStop] $MODE"
+/veto/efficiency/mode $MODE
+/random/setSeeds 12345 67890
+/run/beamOn $NEV
+MAC
+done
+
+"$EXE" "$MAC" 2>/dev/null | awk '
+    /^\[EarlyStop\]/                  { name = $2; order[n++] = name }
+    /^\[Efficiency\] npe >=/          { eff[name] = $9; err[name] = $11; cpu[name] = $16 }
+    /^\[Efficiency\] validate/        { saved[name] = $6 }
+    END {
+        ref = order[0];
+        printf "%-9s %10s %20s %8s %14s\n", "mode", "CPU ms/ev", "efficiency", "dev/sig", "saved ms/ev";
+        for (i = 0; i < n; i++) {
+            k = order[i];
+            s = sqrt(err[k]^2 + err[ref]^2); d = eff[k] - eff[ref];
+            printf "%-9s %10.2f %10.4f +- %6.4f %8.2f %14s\n", k, cpu[k], eff[k], err[k],
+                   (s > 0 ? d/s : 0), (k in saved ? saved[k] : "-");
+        }
+        if (cpu["on"] > 0) printf "speed-up (validate / on): %.2f\n", cpu[ref] / cpu["on"];
+    }'
+rm -f "$MAC"
@@ -0,0 +1,29 @@
+#!/bin/bash
+# boolean / nested 형상 모드 비교: navigation 비용과 npe 일치 여부
+#  사용법: scripts/compare_geometry.sh [실행 파일 경로] [이벤트 수]   (build 디렉토리에서 실행)
+EXE=${1:-./SiPM_Scintillator}
+NEV=${2:-2000}
+MAC=$(mktemp /tmp/compare_geometry_XXXX.mac)
+
+declare -A MEAN ERR
+for MODE in boolean nested; do
+    cat > "$MAC" <<MAC
+/veto/geometry/mode $MODE
+/run/initialize
+/veto/geometry/benchmark 1000000
+/random/setSeeds 12345 67890
+/run/beamOn $NEV
+MAC
+    OUT=$("$EXE" "$MAC" 2>/dev/null)
+    echo "== $MODE"
+    echo "$OUT" | grep -E "^\[Navigation\]|^CPU time per event|^Mean npe"
+    read -r MEAN[$MODE] ERR[$MODE] < <(echo "$OUT" | awk '/^Mean npe/ {print $4, $6}')
+done
+rm -f "$MAC"
+
+# |Δ| / σ < 3 이면 일치
+awk -v m1="${MEAN[boolean]}" -v e1="${ERR[boolean]}" -v m2="${MEAN[nested]}" -v e2="${ERR[nested]}" 'BEGIN {
+    s = sqrt(e1*e1 + e2*e2); d = (m1 > m2) ? m1 - m2 : m2 - m1;
+    printf "npe boolean %.3f +- %.3f, nested %.3f +- %.3f : %.2f sigma -> %s\n",
+           m1, e1, m2, e2, (s > 0 ? d/s : 0), (s > 0 && d/s < 3) ? "MATCH" : "MISMATCH";
+}'
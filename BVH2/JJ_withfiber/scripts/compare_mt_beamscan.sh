@@ -0,0 +1,52 @@
+#!/bin/bash
+# 빔 스캔 맵의 스레드 수 의존성 확인: 1 스레드 vs N 스레드 (같은 macros/beam_scan.mac)
+#  점마다 (MT - 1T) / 오차 의 pull 분포를 출력 → SD 가 워커마다 붙어 있으면 |pull| ~ 1
+#  (스레드마다 난수 흐름이 달라 bin 값이 똑같지는 않음, 통계적으로만 일치)
+#  사용법: scripts/compare_mt_beamscan.sh [실행 파일 경로] [스레드 수]   (build 디렉토리에서 실행)
+EXE=${1:-./SiPM_Scintillator}
+NT=${2:-8}
+DIR=$(mktemp -d /tmp/compare_mt_XXXX)
+
+for T in 1 $NT; do
+    cat > "$DIR/run.mac" <<MAC
+/veto/output/file $DIR/beamscan_t$T.root
+/random/setSeeds 12345 67890
+/control/execute ../macros/beam_scan.mac
+MAC
+    echo "== $T thread(s)"
+    "$EXE" "$DIR/run.mac" $T 2>/dev/null | grep -E "^\[BeamScan\]"
+done
+
+cat > "$DIR/compare.C" <<C
+void compare() {
+    TFile a("$DIR/beamscan_t1.root"), b("$DIR/beamscan_t$NT.root");
+    for (int k = 0; ; k++) {
+        bool found = false;
+        for (const char* name : {"hEff", "hMeanNpe"}) {
+            TString path = TString::Format("beamScan/%s_th%d", name, k);
+            auto h1 = (TH2*)a.Get(path);
+            auto hN = (TH2*)b.Get(path);
+            if (!h1 || !hN) continue;
+            found = true;
+            double sum2 = 0., maxPull = 0.;
+            int n = 0, empty = 0;
+            for (int i = 1; i <= h1->GetNbinsX(); i++)
+                for (int j = 1; j <= h1->GetNbinsY(); j++) {
+                    double v1 = h1->GetBinContent(i, j), vN = hN->GetBinContent(i, j);
+                    double e = std::hypot(h1->GetBinError(i, j), hN->GetBinError(i, j));
+                    if (vN == 0. && v1 > 0.) empty++;
+                    if (e <= 0.) continue;
+                    double pull = (vN - v1) / e;
+                    sum2 += pull*pull;
+                    maxPull = std::max(maxPull, std::abs(pull));
+                    n++;
+                }
+            printf("%-12s th%d  bins %3d  chi2/ndf %.2f  max|pull| %.2f  empty in MT %d\n",
+                   name, k, n, n ? sum2/n : 0., maxPull, empty);
+        }
+        if (!found) break;
+    }
+}
+C
+root -l -b -q "$DIR/compare.C"
+rm -rf "$DIR"
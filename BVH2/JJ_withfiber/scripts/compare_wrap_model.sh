@@ -0,0 +1,34 @@
+#!/bin/bash
+# 테플론 반사: 해석 모델(unified groundfrontpainted) vs lookup 테이블
+#  반사 샘플링 속도 (반사/초), 이벤트당 CPU, npe 일치 여부
+#  사용법: scripts/compare_wrap_model.sh [실행 파일 경로] [이벤트 수] [테이블 파일(선택)]
+#          (build 디렉토리에서 실행)
+EXE=${1:-./SiPM_Scintillator}
+NEV=${2:-2000}
+TABLE=${3:-}
+MAC=$(mktemp /tmp/compare_wrap_model_XXXX.mac)
+
+declare -A MEAN ERR
+for MODEL in analytic table; do
+    {
+        # 경계 프로세스 교체는 물리 구성 때 결정 → 모델 선택은 초기화 전
+        [ "$MODEL" = table ] && [ -n "$TABLE" ] && echo "/veto/surface/wrapTable $TABLE"
+        echo "/veto/surface/wrapModel $MODEL"
+        echo "/run/initialize"
+        [ "$MODEL" = table ] && echo "/veto/surface/wrapBenchmark 10000000"
+        echo "/random/setSeeds 12345 67890"
+        echo "/run/beamOn $NEV"
+    } > "$MAC"
+    OUT=$("$EXE" "$MAC" 2>/dev/null)
+    echo "== $MODEL"
+    echo "$OUT" | grep -E "^\[WrapTable\]|^Optical steps per photon|^CPU time per event|^Mean npe"
+    read -r MEAN[$MODEL] ERR[$MODEL] < <(echo "$OUT" | awk '/^Mean npe/ {print $4, $6}')
+done
+rm -f "$MAC"
+
+# |Δ| / σ < 3 이면 일치
+awk -v m1="${MEAN[analytic]}" -v e1="${ERR[analytic]}" -v m2="${MEAN[table]}" -v e2="${ERR[table]}" 'BEGIN {
+    s = sqrt(e1*e1 + e2*e2); d = (m1 > m2) ? m1 - m2 : m2 - m1;
+    printf "npe analytic %.3f +- %.3f, table %.3f +- %.3f : %.2f sigma -> %s\n",
+           m1, e1, m2, e2, (s > 0 ? d/s : 0), (s > 0 && d/s < 3) ? "MATCH" : "MISMATCH";
+}'
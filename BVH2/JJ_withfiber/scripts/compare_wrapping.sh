@@ -0,0 +1,32 @@
+#!/bin/bash
+# 테플론 포장 비교: 판(slabs) vs 표면(surface), 둘 다 nested 형상
+#  광자당 스텝 수 절감과 npe 변화 (|Δ|/σ) 보고
+#  사용법: scripts/compare_wrapping.sh [실행 파일 경로] [이벤트 수]   (build 디렉토리에서 실행)
+EXE=${1:-./SiPM_Scintillator}
+NEV=${2:-2000}
+MAC=$(mktemp /tmp/compare_wrapping_XXXX.mac)
+
+declare -A MEAN ERR STEPS
+for WRAP in slabs surface; do
+    cat > "$MAC" <<MAC
+/veto/geometry/mode nested
+/veto/geometry/wrapping $WRAP
+/run/initialize
+/random/setSeeds 12345 67890
+/run/beamOn $NEV
+MAC
+    OUT=$("$EXE" "$MAC" 2>/dev/null)
+    echo "== $WRAP"
+    echo "$OUT" | grep -E "^Optical steps per photon|^CPU time per event|^Mean npe"
+    read -r MEAN[$WRAP] ERR[$WRAP] < <(echo "$OUT" | awk '/^Mean npe/ {print $4, $6}')
+    STEPS[$WRAP]=$(echo "$OUT" | awk '/^Optical steps per photon/ {print $5}')
+done
+rm -f "$MAC"
+
+awk -v s1="${STEPS[slabs]}" -v s2="${STEPS[surface]}" \
+    -v m1="${MEAN[slabs]}" -v e1="${ERR[slabs]}" -v m2="${MEAN[surface]}" -v e2="${ERR[surface]}" 'BEGIN {
+    s = sqrt(e1*e1 + e2*e2); d = m2 - m1;
+    printf "steps/photon slabs %.1f, surface %.1f (x%.2f)\n", s1, s2, (s2 > 0 ? s1/s2 : 0);
+    printf "npe slabs %.3f +- %.3f, surface %.3f +- %.3f : %+.2f sigma\n",
+           m1, e1, m2, e2, (s > 0 ? d/s : 0);
+}'
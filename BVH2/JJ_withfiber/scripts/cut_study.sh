@@ -0,0 +1,48 @@
+#!/bin/bash
+# 영역별 production cut 연구: 설정마다 CPU/event 와 평균 npe, 기준(전부 0.01 mm) 대비 차이
+#  한 프로세스에서 /veto/cuts/... 만 바꿔 가며 반복 (형상/광학 초기화 1회)
+#  사용법: scripts/cut_study.sh [실행 파일 경로] [이벤트 수]   (build 디렉토리에서 실행)
+EXE=${1:-./SiPM_Scintillator}
+NEV=${2:-2000}
+MAC=$(mktemp /tmp/cut_study_XXXX.mac)
+
+#       이름        segment fiber passive world eMinOutside(keV)
+SETTINGS=(
+  "reference   0.01 0.01 0.01 0.01 0"
+  "passive1mm  0.01 0.01 1    1    0"
+  "fiber0.1mm  0.01 0.1  1    1    0"
+  "outside1mm  0.01 1    1    1    0"
+  "eMin100keV  0.01 1    1    1    100"
+  "segment0.1  0.1  1    1    1    100"
+  "segment1mm  1    1    1    1    100"
+)
+
+echo "/run/initialize" > "$MAC"
+for S in "${SETTINGS[@]}"; do
+    read -r NAME SEG FIB PAS WLD EMIN <<< "$S"
+    cat >> "$MAC" <<MAC
+/control/echo "[CutStudy] $NAME"
+/veto/cuts/segment $SEG mm
+/veto/cuts/fiber $FIB mm
+/veto/cuts/passive $PAS mm
+/veto/cuts/world $WLD mm
+/veto/cuts/eMinOutside $EMIN keV
+/random/setSeeds 12345 67890
+/run/beamOn $NEV
+MAC
+done
+
+"$EXE" "$MAC" 2>/dev/null | awk '
+    /^\[CutStudy\]/        { name = $2 }
+    /^Mean npe/            { mean[name] = $4; err[name] = $6 }
+    /^CPU time per event/  { cpu[name] = $5; order[n++] = name }
+    END {
+        ref = order[0];
+        printf "%-12s %10s %18s %8s\n", "setting", "CPU ms/ev", "mean npe", "dev/sig";
+        for (i = 0; i < n; i++) {
+            k = order[i];
+            s = sqrt(err[k]^2 + err[ref]^2); d = mean[k] - mean[ref];
+            printf "%-12s %10.2f %10.3f +- %5.3f %8.2f\n", k, cpu[k], mean[k], err[k], (s > 0 ? d/s : 0);
+        }
+    }'
+rm -f "$MAC"
@@ -3,10 +3,16 @@
 #include "RunAction.hh"
 #include "EventAction.hh"
 #include "SteppingAction.hh"
+#include "TrackingAction.hh"
+#include "StackingAction.hh"
 
 ActionInitialization::ActionInitialization() : G4VUserActionInitialization() {}
 ActionInitialization::~ActionInitialization() {}
 
+void ActionInitialization::BuildForMaster() const {
+    SetUserAction(new RunAction());
+}
+
 void ActionInitialization::Build() const {
     SetUserAction(new PrimaryGeneratorAction());
 
@@ -18,5 +24,8 @@ void ActionInitialization::Build() const {
 
     auto steppingAction = new SteppingAction(eventAction); // 수정: EventAction 전달
     SetUserAction(steppingAction);
+
+    SetUserAction(new TrackingAction(eventAction));
+    SetUserAction(new StackingAction());
 }
 
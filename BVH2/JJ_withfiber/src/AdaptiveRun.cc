@@ -0,0 +1,130 @@
+#include "AdaptiveRun.hh"
+
+#include "G4GenericMessenger.hh"
+#include "G4RunManager.hh"
+#include "G4AutoLock.hh"
+
+#include <algorithm>
+#include <cmath>
+
+G4bool              AdaptiveRun::fActive = false;
+G4bool              AdaptiveRun::fConverged = false;
+AdaptiveRun::Target AdaptiveRun::fTarget = AdaptiveRun::kMeanNpe;
+G4double            AdaptiveRun::fPrecision = 0.01;
+G4int               AdaptiveRun::fThreshold = 1;
+G4int               AdaptiveRun::fBin = 10;
+G4int               AdaptiveRun::fCheckEvery = 1000;
+G4int               AdaptiveRun::fMinEvents = 100;
+G4int               AdaptiveRun::fMaxEvents = 10000000;
+
+G4long   AdaptiveRun::fN = 0;
+G4double AdaptiveRun::fSum = 0.;
+G4double AdaptiveRun::fSum2 = 0.;
+G4long   AdaptiveRun::fNAbove = 0;
+G4long   AdaptiveRun::fNBin = 0;
+G4double AdaptiveRun::fLastError = 0.;
+
+namespace {
+    G4Mutex adaptiveMutex = G4MUTEX_INITIALIZER;
+    const char* kTargetNames[] = {"npe", "efficiency", "bin"};
+}
+
+AdaptiveRun::AdaptiveRun()
+{
+    DefineCommands();
+}
+
+AdaptiveRun::~AdaptiveRun()
+{
+    delete fMessenger;
+}
+
+void AdaptiveRun::DefineCommands()
+{
+    fMessenger = new G4GenericMessenger(this, "/veto/adaptive/", "Run until a target precision is reached");
+    fMessenger->DeclareMethod("target", &AdaptiveRun::SetTarget,
+                              "npe (mean) | efficiency (npe >= threshold) | bin (hNpe bin count)")
+        .SetCandidates("npe efficiency bin").SetToBeBroadcasted(false);
+    fMessenger->DeclareProperty("precision", fPrecision, "Target relative uncertainty")
+        .SetParameterName("r", false).SetRange("r>0").SetToBeBroadcasted(false);
+    fMessenger->DeclareProperty("threshold", fThreshold, "Efficiency threshold in photoelectrons")
+        .SetToBeBroadcasted(false);
+    fMessenger->DeclareProperty("bin", fBin, "npe value of the hNpe bin for the bin target")
+        .SetToBeBroadcasted(false);
+    fMessenger->DeclareProperty("checkEvery", fCheckEvery, "Convergence check interval in events")
+        .SetParameterName("n", false).SetRange("n>0").SetToBeBroadcasted(false);
+    fMessenger->DeclareProperty("minEvents", fMinEvents, "Events before the first convergence check")
+        .SetToBeBroadcasted(false);
+    fMessenger->DeclareProperty("maxEvents", fMaxEvents, "Upper limit (BeamOn count)")
+        .SetParameterName("n", false).SetRange("n>0").SetToBeBroadcasted(false);
+    fMessenger->DeclareMethod("run", &AdaptiveRun::Run, "Run until the target precision is reached")
+        .SetToBeBroadcasted(false);
+}
+
+void AdaptiveRun::SetTarget(const G4String& target)
+{
+    fTarget = (target == "efficiency") ? kEfficiency : (target == "bin") ? kBin : kMeanNpe;
+}
+
+G4double AdaptiveRun::RelativeError()
+{
+    if (fN == 0) return kInfinity;
+    const G4double n = fN;
+    switch (fTarget) {
+        case kEfficiency: {
+            if (fNAbove == 0) return kInfinity;
+            G4double p = fNAbove / n;
+            return std::sqrt(p*(1. - p)/n) / p;
+        }
+        case kBin:
+            return fNBin > 0 ? 1. / std::sqrt(G4double(fNBin)) : kInfinity;
+        default: {
+            G4double mean = fSum / n;
+            if (mean <= 0.) return kInfinity;
+            G4double var = std::max(fSum2/n - mean*mean, 0.);
+            return std::sqrt(var/n) / mean;
+        }
+    }
+}
+
+void AdaptiveRun::RecordEvent(G4int npe)
+{
+    G4bool stop = false;
+    {
+        G4AutoLock lock(&adaptiveMutex);
+        fN++;
+        fSum  += npe;
+        fSum2 += G4double(npe)*npe;
+        if (npe >= fThreshold) fNAbove++;
+        if (npe == fBin) fNBin++;
+        if (!fConverged && fN >= fMinEvents && fN % fCheckEvery == 0) {
+            fLastError = RelativeError();
+            fConverged = fLastError <= fPrecision;
+        }
+        stop = fConverged;
+    }
+    // 이 스레드의 이벤트 루프만 중단 → 다른 스레드는 각자 다음 이벤트 끝에서
+    if (stop) G4RunManager::GetRunManager()->AbortRun(true);
+}
+
+void AdaptiveRun::Run()
+{
+    fN = fNAbove = fNBin = 0;
+    fSum = fSum2 = 0.;
+    fLastError = kInfinity;
+    fConverged = false;
+    fActive = true;
+    G4cout << "[Adaptive] target " << kTargetNames[fTarget] << " relative uncertainty "
+           << fPrecision << ", check every " << fCheckEvery << " events, at most "
+           << fMaxEvents << G4endl;
+    G4RunManager::GetRunManager()->BeamOn(fMaxEvents);
+    fActive = false;
+
+    // 마지막 확인 뒤 처리된 이벤트까지 포함한 최종 값
+    const G4double error = RelativeError();
+    const G4double mean = fN > 0 ? fSum / fN : 0.;
+    G4cout << "[Adaptive] " << (fConverged ? "converged" : "NOT converged") << " after " << fN
+           << " events | mean npe " << mean << " | efficiency (npe >= " << fThreshold << ") "
+           << (fN > 0 ? G4double(fNAbove) / fN : 0.) << " | " << kTargetNames[fTarget]
+           << " relative uncertainty " << error << G4endl;
+}
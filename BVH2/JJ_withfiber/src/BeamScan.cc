@@ -0,0 +1,77 @@
+#include "BeamScan.hh"
+
+#include "G4GenericMessenger.hh"
+#include "G4RunManager.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <sstream>
+
+G4bool                BeamScan::fActive = false;
+G4int                 BeamScan::fEventsPerPoint = 500;
+G4int                 BeamScan::fThreshold = 1;
+std::vector<G4double> BeamScan::fYs{-4.*mm, -2.*mm, 0., 2.*mm, 4.*mm};
+std::vector<G4double> BeamScan::fZs{-60.*mm, -40.*mm, -20.*mm, 0., 20.*mm, 40.*mm, 60.*mm};
+std::vector<G4double> BeamScan::fThetas{0.};
+
+namespace {
+    std::vector<G4double> ParseList(const G4String& list, G4double unit)
+    {
+        std::vector<G4double> v;
+        std::istringstream is(list);
+        G4double x;
+        while (is >> x) v.push_back(x * unit);
+        return v;
+    }
+}
+
+BeamScan::BeamScan()
+{
+    DefineCommands();
+}
+
+BeamScan::~BeamScan()
+{
+    delete fMessenger;
+}
+
+void BeamScan::DefineCommands()
+{
+    fMessenger = new G4GenericMessenger(this, "/veto/beamscan/", "Entry position/angle efficiency scan");
+    fMessenger->DeclareMethod("ys", &BeamScan::SetYs, "Entry y grid across the bar width in mm")
+        .SetToBeBroadcasted(false);
+    fMessenger->DeclareMethod("zs", &BeamScan::SetZs, "Entry z grid along the bar in mm")
+        .SetToBeBroadcasted(false);
+    fMessenger->DeclareMethod("thetas", &BeamScan::SetThetas, "Incident angle grid in deg (x-z plane)")
+        .SetToBeBroadcasted(false);
+    fMessenger->DeclareProperty("eventsPerPoint", fEventsPerPoint, "Events per grid point")
+        .SetParameterName("n", false).SetRange("n>0").SetToBeBroadcasted(false);
+    fMessenger->DeclareProperty("threshold", fThreshold, "Efficiency threshold in photoelectrons")
+        .SetToBeBroadcasted(false);
+    fMessenger->DeclareMethod("run", &BeamScan::Run, "Run the whole grid in one BeamOn")
+        .SetToBeBroadcasted(false);
+}
+
+void BeamScan::SetYs(const G4String& list)     { fYs = ParseList(list, mm); }
+void BeamScan::SetZs(const G4String& list)     { fZs = ParseList(list, mm); }
+void BeamScan::SetThetas(const G4String& list) { fThetas = ParseList(list, deg); }
+
+void BeamScan::GetPoint(G4int point, G4double& y, G4double& z, G4double& theta)
+{
+    const G4int nY = fYs.size(), nZ = fZs.size();
+    y     = fYs[point % nY];
+    z     = fZs[(point / nY) % nZ];
+    theta = fThetas[point / (nY*nZ)];
+}
+
+void BeamScan::Run()
+{
+    const G4int nPoints = GetNumberOfPoints();
+    if (nPoints == 0) {
+        G4cout << "[BeamScan] empty grid." << G4endl;
+        return;
+    }
+    G4cout << "[BeamScan] " << nPoints << " points x " << fEventsPerPoint << " events" << G4endl;
+    fActive = true;
+    G4RunManager::GetRunManager()->BeamOn(nPoints * fEventsPerPoint);
+    fActive = false;
+}
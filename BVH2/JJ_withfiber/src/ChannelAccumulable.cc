@@ -0,0 +1,48 @@
+#include "ChannelAccumulable.hh"
+
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+
+const G4double ChannelAccumulable::kTimeMax = 100.*ns;
+
+ChannelAccumulable::ChannelAccumulable(const G4String& name)
+    : G4VAccumulable(name)
+{}
+
+void ChannelAccumulable::Fill(G4int channel, G4int npe, G4double firstTime,
+                              G4double wlSum, G4double wlSum2, G4int wlN)
+{
+    auto& s = fChannels[channel];
+    s.nFired++;
+    s.npeSum += npe;
+    s.npeSum2 += G4double(npe)*npe;
+    s.wlSum  += wlSum;
+    s.wlSum2 += wlSum2;
+    s.wlN    += wlN;
+    s.npeCounts[std::min(npe, kNpeBins)]++;
+    if (npe <= 0) return;
+    G4int t = G4int(firstTime / kTimeMax * kTimeBins);
+    s.timeCounts[std::min(std::max(t, 0), kTimeBins)]++;
+}
+
+void ChannelAccumulable::Merge(const G4VAccumulable& other)
+{
+    const auto& rhs = static_cast<const ChannelAccumulable&>(other);
+    for (const auto& [channel, o] : rhs.fChannels) {
+        auto& s = fChannels[channel];
+        s.nFired += o.nFired;
+        s.npeSum += o.npeSum;
+        s.npeSum2 += o.npeSum2;
+        s.wlSum  += o.wlSum;
+        s.wlSum2 += o.wlSum2;
+        s.wlN    += o.wlN;
+        for (G4int i = 0; i <= kNpeBins; i++)  s.npeCounts[i]  += o.npeCounts[i];
+        for (G4int i = 0; i <= kTimeBins; i++) s.timeCounts[i] += o.timeCounts[i];
+    }
+}
+
+void ChannelAccumulable::Reset()
+{
+    fChannels.clear();
+}
@@ -0,0 +1,91 @@
+#include "CosmicMuonSpectrum.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+#include "CLHEP/Units/PhysicalConstants.h"
+
+#include <algorithm>
+#include <cmath>
+
+const G4double CosmicMuonSpectrum::kMuPlusOverMinus = 1.27;
+
+namespace {
+    // Guan et al. 지구 곡률 보정 cos(θ*)
+    G4double CurvedCos(G4double c)
+    {
+        const G4double p1 = 0.102573, p2 = -0.068287, p3 = 0.958633, p4 = 0.0407253, p5 = 0.817285;
+        return std::sqrt((c*c + p1*p1 + p2*std::pow(c, p3) + p4*std::pow(c, p5))
+                         / (1. + p1*p1 + p2 + p4));
+    }
+}
+
+G4double CosmicMuonSpectrum::Intensity(G4double energy, G4double cosTheta)
+{
+    const G4double e  = energy / GeV;
+    const G4double cs = CurvedCos(cosTheta);
+    return 0.14 * std::pow(e*(1. + 3.64/(e*std::pow(cs, 1.29))), -2.7)
+                * (1./(1. + 1.1*e*cs/115.) + 0.054/(1. + 1.1*e*cs/850.));
+}
+
+CosmicMuonSpectrum::CosmicMuonSpectrum(G4double eMin, G4double eMax, G4double cosMin)
+    : fEMin(eMin), fEMax(eMax), fCosMin(cosMin),
+      fLogEMin(std::log(eMin)), fDLogE(std::log(eMax/eMin) / kNE), fDCos((1. - cosMin) / kNCos)
+{
+    std::vector<G4double> weights(kNE*kNCos);
+    G4double sum = 0.;
+    for (G4int i = 0; i < kNE; i++) {
+        G4double e = std::exp(fLogEMin + (i + 0.5)*fDLogE);
+        for (G4int j = 0; j < kNCos; j++) {
+            G4double c = fCosMin + (j + 0.5)*fDCos;
+            // dE = E d(lnE), dΩ = 2π dcosθ
+            G4double w = Intensity(e, c) * (e/GeV) * fDLogE * fDCos * CLHEP::twopi;
+            weights[i*kNCos + j] = w;
+            sum += w;
+            fMeanCos += w*c;
+            fMeanSin += w*std::sqrt(1. - c*c);
+        }
+    }
+    fTotal = sum / (cm2*s);
+    fMeanCos /= sum;
+    fMeanSin /= sum;
+    BuildAlias(weights);
+}
+
+// ----------------------------------------------------------------------
+// Vose alias 테이블
+// ----------------------------------------------------------------------
+void CosmicMuonSpectrum::BuildAlias(const std::vector<G4double>& weights)
+{
+    const G4int n = weights.size();
+    G4double sum = 0.;
+    for (auto w : weights) sum += w;
+
+    fProb.assign(n, 1.);
+    fAlias.resize(n);
+    std::vector<G4double> scaled(n);
+    std::vector<G4int> small, large;
+    for (G4int k = 0; k < n; k++) {
+        fAlias[k] = k;
+        scaled[k] = weights[k] * n / sum;
+        (scaled[k] < 1. ? small : large).push_back(k);
+    }
+    while (!small.empty() && !large.empty()) {
+        G4int s = small.back(); small.pop_back();
+        G4int l = large.back();
+        fProb[s]  = scaled[s];
+        fAlias[s] = l;
+        scaled[l] -= 1. - scaled[s];
+        if (scaled[l] < 1.) { large.pop_back(); small.push_back(l); }
+    }
+    // 남은 셀은 수치 오차 → 확률 1 그대로
+}
+
+void CosmicMuonSpectrum::Sample(G4double& energy, G4double& cosTheta) const
+{
+    const G4int n = fProb.size();
+    G4int k = std::min(G4int(G4UniformRand()*n), n - 1);
+    if (G4UniformRand() >= fProb[k]) k = fAlias[k];
+    G4int i = k / kNCos, j = k % kNCos;
+    energy   = std::exp(fLogEMin + (i + G4UniformRand())*fDLogE);
+    cosTheta = fCosMin + (j + G4UniformRand())*fDCos;
+}
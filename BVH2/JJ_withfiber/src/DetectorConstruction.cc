@@ -16,14 +16,112 @@
 #include "G4SubtractionSolid.hh"
 #include "G4Tubs.hh"
 #include "G4Colour.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4GenericMessenger.hh"
+#include "G4StateManager.hh"
+#include "FiberTransportModel.hh"
+#include "SegmentResponseModel.hh"
+#include "YieldScan.hh"
+#include "ResourceUsage.hh"
+#include "OpticalSurfaceRegistry.hh"
+#include "WrapReflectanceTable.hh"
+#include "G4Timer.hh"
+#include "CLHEP/Random/MixMaxRng.h"
+#include "CLHEP/Random/RandFlat.h"
+#include "G4Navigator.hh"
+#include "G4TransportationManager.hh"
+#include <algorithm>
 #include <cmath>
+#include <fstream>
+#include <sstream>
 #include <string>
+#include <vector>
+
+DetectorConstruction::DetectorConstruction()
+  : fScintX(2*mm), fScintY(10*mm), fScintZ(140*mm),
+    fGrooveSize(1.2*mm), fFiberLength(180*mm), fFiberZCenter(+20*mm), fFiberCladRadius(0.5*mm),
+    fWrapThickness(0.01*mm), fWrapReflectivity(0.98),
+    fCouplingThickness(0.10*mm), fSiPMSize(1.3*mm), fSiPMThickness(0.3*mm),
+    fNColumns(1), fNLayers(1), fPitchX(0.), fPitchY(0.),
+    fCheckOverlaps(true)
+{
+  DefineCommands();
+}
+DetectorConstruction::~DetectorConstruction() {
+  delete fFiberMessenger;
+  delete fScintMessenger;
+  delete fArrayMessenger;
+  delete fSurfaceMessenger;
+  delete fGeometryMessenger;
+}
 
-DetectorConstruction::DetectorConstruction() {}
-DetectorConstruction::~DetectorConstruction() {}
+// 세그먼트 envelope: 테플론 포장 + 파이버 돌출부 + SiPM 까지
+namespace {
+  const G4double kEnvelopeGap  = 0.01*mm;
+  const G4double kCoreFraction = 0.96;
+}
 
-G4VPhysicalVolume* DetectorConstruction::Construct() {
+G4double DetectorConstruction::GetEnvelopeHalfX() const {
+  // SiPM 은 파이버 축(+X 쪽)에 중심 → 포장보다 +X 로 튀어나옴
+  G4double sipmEdge = fScintX/2 - fFiberCladRadius + fSiPMSize/2;
+  return std::max(fScintX/2 + fWrapThickness, sipmEdge) + kEnvelopeGap;
+}
+
+G4double DetectorConstruction::GetPitchX() const {
+  return fPitchX > 0. ? fPitchX : 2*GetEnvelopeHalfX();
+}
+
+G4double DetectorConstruction::GetFiberCoreRadius() const {
+  return kCoreFraction*fFiberCladRadius;
+}
+
+G4double DetectorConstruction::GetPitchY() const {
+  return fPitchY > 0. ? fPitchY : fScintY + 2*(fWrapThickness + kEnvelopeGap);
+}
+
+G4ThreeVector DetectorConstruction::GetSegmentPosition(G4int copyNo) const {
+  G4int layer = copyNo / fNColumns, column = copyNo % fNColumns;
+  return G4ThreeVector((layer  - 0.5*(fNLayers  - 1))*GetPitchX(),
+                       (column - 0.5*(fNColumns - 1))*GetPitchY(), 0.);
+}
 
+// Construct() 의 envelope 크기와 같은 식
+void DetectorConstruction::GetArrayBounds(G4ThreeVector& pMin, G4ThreeVector& pMax) const {
+  G4ThreeVector half(GetEnvelopeHalfX(), fScintY/2 + fWrapThickness + kEnvelopeGap, 0.);
+  G4ThreeVector first = GetSegmentPosition(0), last = GetSegmentPosition(GetNumberOfSegments() - 1);
+  pMin.set(first.x() - half.x(), first.y() - half.y(), -(fScintZ/2 + fWrapThickness + kEnvelopeGap));
+  pMax.set(last.x() + half.x(), last.y() + half.y(),
+           fFiberZCenter + fFiberLength/2 + fCouplingThickness + fSiPMThickness + kEnvelopeGap);
+}
+
+// 파이버 중심 x = 신틸 +X 면 - clad 반지름 (groove 안쪽 밀착), SiPM 은 파이버 +Z 끝
+G4ThreeVector DetectorConstruction::GetSiPMPosition(G4int copyNo) const {
+  return GetSegmentPosition(copyNo) +
+         G4ThreeVector(fScintX/2 - fFiberCladRadius, 0.,
+                       fFiberZCenter + fFiberLength/2 + fCouplingThickness + fSiPMThickness/2);
+}
+
+void DetectorConstruction::WriteChannelMap(const G4String& fileName) {
+  std::ofstream out(fileName);
+  if (!out) {
+    G4cout << "[Array] cannot write " << fileName << G4endl;
+    return;
+  }
+  out << "# channel layer column x_mm y_mm z_mm\n";
+  for (G4int ch = 0; ch < GetNumberOfSegments(); ch++) {
+    G4ThreeVector p = GetSiPMPosition(ch);
+    out << ch << " " << ch / fNColumns << " " << ch % fNColumns << " "
+        << p.x()/mm << " " << p.y()/mm << " " << p.z()/mm << "\n";
+  }
+  G4cout << "[Array] channel map (" << GetNumberOfSegments() << " channels) written to "
+         << fileName << G4endl;
+}
+
+// =========================================================
+//  재질 + 광학 물성 (한 번만)
+// =========================================================
+void DetectorConstruction::DefineMaterials() {
   auto nist = G4NistManager::Instance();
   auto worldMat = nist->FindOrBuildMaterial("G4_AIR");
   auto teflonMat = nist->FindOrBuildMaterial("G4_POLYETHYLENE"); // PTFE 근사
@@ -48,6 +146,7 @@ G4VPhysicalVolume* DetectorConstruction::Construct() {
   G4double photonEnergy[NUMENTRIES];
   for (int i=0;i<NUMENTRIES;i++)
     photonEnergy[i] = (CLHEP::h_Planck*CLHEP::c_light)/Wavelength[i];
+  fPhotonEnergies.assign(photonEnergy, photonEnergy + NUMENTRIES);
 
   // EJ-212 scint emission (relative)
   G4double EmissionSpectrum[NUMENTRIES] = {
@@ -62,7 +161,7 @@ G4VPhysicalVolume* DetectorConstruction::Construct() {
   scintMPT->AddProperty("ABSLENGTH",photonEnergy,absLengthScint,NUMENTRIES);
   scintMPT->AddProperty("RINDEX",photonEnergy,rindexScint,NUMENTRIES);
   scintMPT->AddProperty("SCINTILLATIONCOMPONENT1",photonEnergy,EmissionSpectrum,NUMENTRIES);
-  scintMPT->AddConstProperty("SCINTILLATIONYIELD",10000./MeV);
+  scintMPT->AddConstProperty("SCINTILLATIONYIELD",YieldScan::kNominalYield);
   scintMPT->AddConstProperty("RESOLUTIONSCALE",1.0);
   scintMPT->AddConstProperty("SCINTILLATIONTIMECONSTANT1",2.4*ns);
   scintMPT->AddConstProperty("SCINTILLATIONRISETIME1",0.9*ns);
@@ -74,21 +173,19 @@ G4VPhysicalVolume* DetectorConstruction::Construct() {
   airMPT->AddProperty("RINDEX", photonEnergy, airRIndex, NUMENTRIES);
   worldMat->SetMaterialPropertiesTable(airMPT);
 
+  // groove 공기 (중첩 모드): 조성/RINDEX 는 G4_AIR 와 같지만 다른 재질 →
+  //  groove → envelope 경계가 SameMaterial 로 건너뛰어지지 않아 surface 포장이 적용됨
+  auto grooveAir = new G4Material("GrooveAir", worldMat->GetDensity(), worldMat);
+  auto grooveAirMPT = new G4MaterialPropertiesTable();
+  grooveAirMPT->AddProperty("RINDEX", photonEnergy, airRIndex, NUMENTRIES);
+  grooveAir->SetMaterialPropertiesTable(grooveAirMPT);
+
   // ------------------ SiPM RINDEX ------------------
   G4double siRIndex[NUMENTRIES]; for (int i=0;i<NUMENTRIES;i++) siRIndex[i]=1.55;
   auto siMPT = new G4MaterialPropertiesTable();
   siMPT->AddProperty("RINDEX",photonEnergy,siRIndex,NUMENTRIES);
   sipmMat->SetMaterialPropertiesTable(siMPT);
 
-  // ------------------ World ------------------
-  auto solidWorld = new G4Box("World",0.5*m,0.5*m,0.5*m);
-  auto logicWorld = new G4LogicalVolume(solidWorld,worldMat,"World");
-  auto physWorld  = new G4PVPlacement(nullptr,{},logicWorld,"World",nullptr,false,0,true);
-
-  // ------------------ SD ------------------
-  auto siPMSD = new SiPMSensitiveDetector("SiPMSD");
-  G4SDManager::GetSDMpointer()->AddNewDetector(siPMSD);
-
   // =========================================================
   //  Fiber materials (PS core / PMMA cladding) + Optical glue + WLS(간단)
   // =========================================================
@@ -148,6 +245,53 @@ G4VPhysicalVolume* DetectorConstruction::Construct() {
   mptGlue->AddProperty("RINDEX",    photonEnergy, nGlue,  NUMENTRIES);
   mptGlue->AddProperty("ABSLENGTH", photonEnergy, absGlue, NUMENTRIES);
   OpticalGlue->SetMaterialPropertiesTable(mptGlue);
+}
+
+G4VPhysicalVolume* DetectorConstruction::Construct() {
+  // boolean 모드의 groove 공기막은 세그먼트 envelope 자체라 바깥 면과 구분 불가
+  if (fWrappingMode == kSurfaceWrap && fGeometryMode != kNested) {
+    G4Exception("DetectorConstruction::Construct", "Geom002", JustWarning,
+                "Surface wrapping needs the nested geometry; switching to /veto/geometry/mode nested.");
+    fGeometryMode = kNested;
+  }
+
+  G4Timer initTimer;
+  initTimer.Start();
+  const G4double rssStart = ResourceUsage::ResidentMemoryMB();
+
+  // 재질은 한 번만 생성: 형상만 다시 만들 때 (ParameterScan) 같은 재질 →
+  //  material-cuts couple 이 그대로라 물리 테이블 재계산 없음
+  if (!G4Material::GetMaterial("EJ212", false)) DefineMaterials();
+  auto worldMat    = G4Material::GetMaterial("G4_AIR");
+  auto grooveAir   = G4Material::GetMaterial("GrooveAir");
+  auto teflonMat   = G4Material::GetMaterial("G4_POLYETHYLENE");
+  auto sipmMat     = G4Material::GetMaterial("G4_Si");
+  auto scintMat    = G4Material::GetMaterial("EJ212");
+  auto PS_Core     = G4Material::GetMaterial("PS_Core");
+  auto PMMA_Clad   = G4Material::GetMaterial("PMMA_Clad");
+  auto OpticalGlue = G4Material::GetMaterial("OpticalGlue");
+
+  // 이전 형상의 표면은 Geant4 가 정리 → 레지스트리 캐시도 비움
+  OpticalSurfaceRegistry::Instance()->Clear();
+
+  // ------------------ World ------------------
+  // (배열 크기에 맞춰 확장, 최소 1 m 정육면체)
+  G4double envHalfX = GetEnvelopeHalfX();
+  G4double envHalfY = fScintY/2 + fWrapThickness + kEnvelopeGap;
+  G4double envZmin  = -(fScintZ/2 + fWrapThickness + kEnvelopeGap);
+  G4double envZmax  = fFiberZCenter + fFiberLength/2 + fCouplingThickness + fSiPMThickness + kEnvelopeGap;
+  G4double envZc    = 0.5*(envZmin + envZmax);
+
+  G4double worldHalfX = std::max(0.5*m, 0.5*fNLayers*GetPitchX()  + 10*cm);
+  G4double worldHalfY = std::max(0.5*m, 0.5*fNColumns*GetPitchY() + 10*cm);
+  auto solidWorld = new G4Box("World",worldHalfX,worldHalfY,0.5*m);
+  auto logicWorld = new G4LogicalVolume(solidWorld,worldMat,"World");
+  auto physWorld  = new G4PVPlacement(nullptr,{},logicWorld,"World",nullptr,false,0,true);
+
+  // SD 는 스레드별로 ConstructSDandField 에서 붙임 (여기서는 SiPM LV 이름만 기록)
+  fSiPMLVNames.clear();
+  // surface 포장: envelope 로 바로 나가는 세트 안쪽 볼륨 (groove, glue, 안쪽 파이버)
+  std::vector<G4VPhysicalVolume*> wrapExitPVs;
 
   // =========================================================
   //  공통 빌더
@@ -160,159 +304,540 @@ G4VPhysicalVolume* DetectorConstruction::Construct() {
     };
 
     // 신틸 기본 사이즈
-    G4double scint_x=2*mm, scint_y=10*mm, scint_z=140*mm;
+    G4double scint_x=fScintX, scint_y=fScintY, scint_z=fScintZ;
     G4double halfX = scint_x/2, halfY = scint_y/2, halfZ = scint_z/2;
 
     // --- (A) Groove 있는 신틸: +X 끝, 크기 1.2×1.2×140 ---
-    auto solidScintBox = new G4Box("ScintBox"+suffix, halfX, halfY, halfZ);
-
-    G4double groove_x = 1.2*mm;
-    G4double groove_y = 1.2*mm;
+    G4double groove_x = fGrooveSize;
+    G4double groove_y = fGrooveSize;
     G4double groove_z = scint_z; // 140 mm
-
-    auto solidGroove = new G4Box("GrooveBox"+suffix, groove_x/2, groove_y/2, groove_z/2);
     G4ThreeVector grooveShift(+halfX - groove_x/2, 0.0, 0.0); // +X에 밀착
 
-    auto solidScint = new G4SubtractionSolid("ScintWithGroove"+suffix,
-                                             solidScintBox, solidGroove,
-                                             nullptr, grooveShift);
-
-    auto logicScint = new G4LogicalVolume(solidScint, scintMat, "ScintLV"+suffix);
-    auto scintPV    = new G4PVPlacement(rot, pos, logicScint,
-                                        "Scintillator"+suffix, mother,false,0,true);
-
-    // --- (B) Optical glue: Glue = Box - Cylinder(=파이버 자리) ---
     G4double tol = 0.01*mm;
-    auto glueBox = new G4Box("GlueBoxRaw"+suffix,
-                             groove_x/2 - tol, groove_y/2 - tol, groove_z/2 - tol);
-
-    // 파이버 자리(원통) — r_hole = r_clad
-    G4double r_clad = 0.500*mm;   // 싱글클래딩 1.0 mm
-    G4double r_core = 0.480*mm;
-    auto holeCyl = new G4Tubs("GlueHole"+suffix, 0., r_clad, groove_z/2, 0.*deg, 360.*deg);
-
+    G4double r_clad = fFiberCladRadius;   // 싱글클래딩 1.0 mm
+    G4double r_core = kCoreFraction*r_clad; // 0.480 mm (클래딩 = 지름의 2 %)
     // 글루 좌표계에서 +X 끝 밀착: x = 0.6 - 0.5 = +0.1
     G4double x_in_glue = + (groove_x/2 - r_clad);
-    G4ThreeVector holeShift(x_in_glue, 0., 0.);
 
-    auto glueSolid = new G4SubtractionSolid("GlueMinusHole"+suffix,
-                                            glueBox, holeCyl, nullptr, holeShift);
-    auto glueLV    = new G4LogicalVolume(glueSolid, OpticalGlue, "GlueLV"+suffix);
-    auto gluePV    = new G4PVPlacement(rot,
+    G4double L_fiber  = fFiberLength;
+    G4double zC_fiber = fFiberZCenter; // +Z로 40 mm 돌출 → 끝 z=+110
+
+    G4LogicalVolume*   logicScint = nullptr;
+    G4VPhysicalVolume* scintPV = nullptr;
+    G4LogicalVolume*   glueLV = nullptr;
+    G4VPhysicalVolume* gluePV = nullptr;
+    G4VPhysicalVolume* groovePV = nullptr;     // 중첩 모드의 groove 공기
+    G4LogicalVolume*   cladLV = nullptr;       // 파이버 fast-sim envelope
+    std::vector<G4LogicalVolume*> fiberLVs;    // (보기) clad, core 순서 쌍
+
+    if (fGeometryMode == kBoolean) {
+      auto solidScintBox = new G4Box("ScintBox"+suffix, halfX, halfY, halfZ);
+      auto solidGroove = new G4Box("GrooveBox"+suffix, groove_x/2, groove_y/2, groove_z/2);
+      auto solidScint = new G4SubtractionSolid("ScintWithGroove"+suffix,
+                                               solidScintBox, solidGroove,
+                                               nullptr, grooveShift);
+
+      logicScint = new G4LogicalVolume(solidScint, scintMat, "ScintLV"+suffix);
+      scintPV    = new G4PVPlacement(rot, pos, logicScint,
+                                     "Scintillator"+suffix, mother,false,0,true);
+
+      // --- (B) Optical glue: Glue = Box - Cylinder(=파이버 자리) ---
+      auto glueBox = new G4Box("GlueBoxRaw"+suffix,
+                               groove_x/2 - tol, groove_y/2 - tol, groove_z/2 - tol);
+
+      // 파이버 자리(원통) — r_hole = r_clad
+      auto holeCyl = new G4Tubs("GlueHole"+suffix, 0., r_clad, groove_z/2, 0.*deg, 360.*deg);
+      G4ThreeVector holeShift(x_in_glue, 0., 0.);
+
+      auto glueSolid = new G4SubtractionSolid("GlueMinusHole"+suffix,
+                                              glueBox, holeCyl, nullptr, holeShift);
+      glueLV = new G4LogicalVolume(glueSolid, OpticalGlue, "GlueLV"+suffix);
+      gluePV = new G4PVPlacement(rot,
                         pos + ApplyRot(grooveShift, rot),
                         glueLV, "GluePV"+suffix, mother, false, 0, true);
 
+      // --- (C) Fiber: L=180 mm, zC=+20 mm (mother에 배치; glue는 구멍만 제공) ---
+      G4ThreeVector fiberInGlue(x_in_glue, 0.0, zC_fiber);
+      G4ThreeVector fiberWorldPos = pos + ApplyRot(grooveShift + fiberInGlue, rot);
+
+      auto cladSolid = new G4Tubs("FiberClad"+suffix, 0., r_clad, L_fiber/2.0, 0.*deg, 360.*deg);
+      cladLV = new G4LogicalVolume(cladSolid, PMMA_Clad, "FiberCladLV"+suffix);
+      new G4PVPlacement(nullptr, fiberWorldPos,
+                        cladLV, "FiberCladPV"+suffix, mother, false, 0, true);
+
+      auto coreSolid = new G4Tubs("FiberCore"+suffix, 0., r_core, L_fiber/2.0, 0.*deg, 360.*deg);
+      auto coreLV    = new G4LogicalVolume(coreSolid, PS_Core, "FiberCoreLV"+suffix);
+      new G4PVPlacement(nullptr, G4ThreeVector(),
+                        coreLV, "FiberCorePV"+suffix, cladLV, false, 0, true);
+      fiberLVs = {cladLV, coreLV};
+    } else {
+      // ---- Boolean 없는 중첩 배치 ----
+      //  신틸 box ⊃ groove(공기) box ⊃ glue box ⊃ 파이버(안쪽 조각) clad ⊃ core
+      //  파이버 돌출부는 mother 에 따로 배치.
+      //  공기막(tol)은 -X, ±Y 면에 유지; glue 는 파이버가 들어가도록 +X 와 ±Z 를
+      //  groove 면까지 채움 → boolean 모드(글루 모든 면 tol 안쪽) 대비 +X 면과
+      //  ±Z 끝의 10 µm 공기막이 글루로 바뀜 (box 만으로 원통 구멍을 만들 수 없음).
+      auto solidScint = new G4Box("ScintBox"+suffix, halfX, halfY, halfZ);
+      logicScint = new G4LogicalVolume(solidScint, scintMat, "ScintLV"+suffix);
+      scintPV    = new G4PVPlacement(rot, pos, logicScint,
+                                     "Scintillator"+suffix, mother,false,0,true);
+
+      auto grooveBox = new G4Box("GrooveAir"+suffix, groove_x/2, groove_y/2, groove_z/2);
+      auto grooveLV  = new G4LogicalVolume(grooveBox, grooveAir, "GrooveAirLV"+suffix);
+      groovePV = new G4PVPlacement(nullptr, grooveShift, grooveLV, "GrooveAirPV"+suffix,
+                                   logicScint, false, 0, true);
+      grooveLV->SetVisAttributes(G4VisAttributes::GetInvisible());
+
+      // --- (B) Optical glue: x ∈ [-0.59, +0.6] (groove 좌표) ---
+      G4double glueHalfX = (groove_x - tol)/2;
+      G4double glueX     = tol/2;
+      auto glueBox = new G4Box("GlueBox"+suffix, glueHalfX, groove_y/2 - tol, groove_z/2);
+      glueLV = new G4LogicalVolume(glueBox, OpticalGlue, "GlueLV"+suffix);
+      gluePV = new G4PVPlacement(nullptr, G4ThreeVector(glueX, 0., 0.),
+                                 glueLV, "GluePV"+suffix, grooveLV, false, 0, true);
+
+      // --- (C) Fiber: glue 안 (-Z 끝 ~ 신틸 +Z 면) + mother 의 돌출부 ---
+      //  -Z 끝이 신틸 안쪽이면 그 앞 구멍은 boolean 모드처럼 공기
+      G4double zFiberIn  = zC_fiber - L_fiber/2.0;       // -70
+      G4double zFiberEnd = zC_fiber + L_fiber/2.0;       // +110
+      G4double inHalf    = 0.5*(halfZ - zFiberIn);
+      G4double outHalf   = 0.5*(zFiberEnd - halfZ);
+      if (zFiberIn < -halfZ - 1e-9*mm || outHalf <= 0.)
+        G4Exception("DetectorConstruction::Construct", "Geom001", FatalException,
+                    "Nested mode needs the fiber inside the scintillator at -Z and protruding at +Z.");
+
+      auto cladIn  = new G4Tubs("FiberCladIn"+suffix, 0., r_clad, inHalf, 0.*deg, 360.*deg);
+      auto coreIn  = new G4Tubs("FiberCoreIn"+suffix, 0., r_core, inHalf, 0.*deg, 360.*deg);
+      cladLV = new G4LogicalVolume(cladIn, PMMA_Clad, "FiberCladLV"+suffix);
+      auto coreLV = new G4LogicalVolume(coreIn, PS_Core, "FiberCoreLV"+suffix);
+      auto cladInPV = new G4PVPlacement(nullptr, G4ThreeVector(x_in_glue - glueX, 0., zFiberIn + inHalf),
+                                        cladLV, "FiberCladPV"+suffix, glueLV, false, 0, true);
+      auto coreInPV = new G4PVPlacement(nullptr, G4ThreeVector(),
+                                        coreLV, "FiberCorePV"+suffix, cladLV, false, 0, true);
+      G4VPhysicalVolume* holePV = nullptr;
+      G4double holeHalf = 0.5*(zFiberIn + halfZ);
+      if (holeHalf > 1e-9*mm) {
+        auto hole   = new G4Tubs("GlueHoleAir"+suffix, 0., r_clad, holeHalf, 0.*deg, 360.*deg);
+        auto holeLV = new G4LogicalVolume(hole, grooveAir, "GlueHoleAirLV"+suffix);
+        holePV = new G4PVPlacement(nullptr, G4ThreeVector(x_in_glue - glueX, 0., -halfZ + holeHalf),
+                                   holeLV, "GlueHoleAirPV"+suffix, glueLV, false, 0, true);
+        holeLV->SetVisAttributes(G4VisAttributes::GetInvisible());
+      }
+      // groove/glue 는 신틸 +X 면과, glue/파이버(또는 구멍)는 ±Z 면과 같은 평면 → 이 면에서 envelope 로 나감
+      //  (groove/구멍 공기는 GrooveAir 재질 → envelope 공기와의 경계에도 border surface 적용)
+      if (fWrappingMode == kSurfaceWrap) {
+        wrapExitPVs = {groovePV, gluePV, cladInPV, coreInPV};
+        if (holePV) wrapExitPVs.push_back(holePV);
+      }
+
+      auto cladOut = new G4Tubs("FiberCladOut"+suffix, 0., r_clad, outHalf, 0.*deg, 360.*deg);
+      auto coreOut = new G4Tubs("FiberCoreOut"+suffix, 0., r_core, outHalf, 0.*deg, 360.*deg);
+      auto cladOutLV = new G4LogicalVolume(cladOut, PMMA_Clad, "FiberCladOutLV"+suffix);
+      auto coreOutLV = new G4LogicalVolume(coreOut, PS_Core, "FiberCoreOutLV"+suffix);
+      new G4PVPlacement(nullptr,
+                        pos + ApplyRot(grooveShift + G4ThreeVector(x_in_glue, 0., halfZ + outHalf), rot),
+                        cladOutLV, "FiberCladOutPV"+suffix, mother, false, 0, true);
+      new G4PVPlacement(nullptr, G4ThreeVector(),
+                        coreOutLV, "FiberCoreOutPV"+suffix, cladOutLV, false, 0, true);
+      fiberLVs = {cladLV, coreLV, cladOutLV, coreOutLV};
+    }
+    fScintillatorLV = logicScint;
+
+    // 세그먼트 응답 테이블 fast-simulation envelope
+    G4RegionStore::GetInstance()->FindOrCreateRegion("SegmentRegion")
+      ->AddRootLogicalVolume(logicScint);
+
     // (보기)
     auto vGlue = new G4VisAttributes(G4Colour(0.6,0.6,1.0,0.15)); vGlue->SetForceSolid(true);
     glueLV->SetVisAttributes(vGlue);
-
-    // --- (C) Fiber: L=180 mm, zC=+20 mm (mother에 배치; glue는 구멍만 제공) ---
-    G4double L_fiber  = 180.0*mm;
-    G4double zC_fiber = +20.0*mm; // +Z로 40 mm 돌출 → 끝 z=+110
-
-    G4ThreeVector fiberInGlue(x_in_glue, 0.0, zC_fiber);
-    G4ThreeVector fiberWorldPos = pos + ApplyRot(grooveShift + fiberInGlue, rot);
-
-    auto cladSolid = new G4Tubs("FiberClad"+suffix, 0., r_clad, L_fiber/2.0, 0.*deg, 360.*deg);
-    auto cladLV    = new G4LogicalVolume(cladSolid, PMMA_Clad, "FiberCladLV"+suffix);
-    auto cladPV    = new G4PVPlacement(nullptr, fiberWorldPos,
-                                       cladLV, "FiberCladPV"+suffix, mother, false, 0, true);
-
-    auto coreSolid = new G4Tubs("FiberCore"+suffix, 0., r_core, L_fiber/2.0, 0.*deg, 360.*deg);
-    auto coreLV    = new G4LogicalVolume(coreSolid, PS_Core, "FiberCoreLV"+suffix);
-    new G4PVPlacement(nullptr, G4ThreeVector(),
-                      coreLV, "FiberCorePV"+suffix, cladLV, false, 0, true);
-
-    // (보기)
     auto vClad = new G4VisAttributes(G4Colour(0.2,0.8,0.2,0.15)); vClad->SetForceSolid(true);
     auto vCore = new G4VisAttributes(G4Colour(0.2,0.8,0.2,0.35)); vCore->SetForceSolid(true);
-    cladLV->SetVisAttributes(vClad);
-    coreLV->SetVisAttributes(vCore);
+    for (std::size_t i = 0; i < fiberLVs.size(); i++)
+      fiberLVs[i]->SetVisAttributes(i % 2 == 0 ? vClad : vCore);
+
+    // 파이버 fast-simulation envelope (clad + core daughter)
+    //  중첩 모드에서는 안쪽 조각만: 모델이 -Z 끝(테플론)부터 +Z 끝까지 수송하고
+    //  돌출부 조각은 Geant4 가 추적
+    G4RegionStore::GetInstance()->FindOrCreateRegion("FiberRegion")
+      ->AddRootLogicalVolume(cladLV);
 
     // --- (D) Coupling disk (OpticalGlue, 0.1 mm) + SiPM ---
     G4double zEnd  = zC_fiber + L_fiber/2.0;           // 파이버 +Z 끝 (+110)
-    G4double coupT = 0.10*mm;
+    G4double coupT = fCouplingThickness;
 
     auto coupDisk  = new G4Tubs("CouplingDisk"+suffix, 0., r_clad, coupT/2.0, 0.*deg, 360.*deg);
     auto coupLV    = new G4LogicalVolume(coupDisk, OpticalGlue, "CouplingLV"+suffix);
-    auto coupPV    = new G4PVPlacement(nullptr,
-                         pos + ApplyRot(grooveShift + G4ThreeVector(x_in_glue,0., zEnd + coupT/2.0), rot),
-                         coupLV, "CouplingPV"+suffix, mother, false, 0, true);
+    new G4PVPlacement(nullptr,
+                      pos + ApplyRot(grooveShift + G4ThreeVector(x_in_glue,0., zEnd + coupT/2.0), rot),
+                      coupLV, "CouplingPV"+suffix, mother, false, 0, true);
 
-    G4double siPMSizeXY = 1.3*mm, siPMThick = 0.3*mm;
+    G4double siPMSizeXY = fSiPMSize, siPMThick = fSiPMThickness;
     auto siPMBox   = new G4Box("SiPM"+suffix, siPMSizeXY/2, siPMSizeXY/2, siPMThick/2);
     auto siPMLogic = new G4LogicalVolume(siPMBox, sipmMat, "SiPMLogic"+suffix);
-    siPMLogic->SetSensitiveDetector(siPMSD);
+    fSiPMLVNames.push_back(siPMLogic->GetName());
 
     G4double zSiPM = zEnd + coupT + siPMThick/2.0;
-    auto sipmPV = new G4PVPlacement(rot,
-                    pos + ApplyRot(grooveShift + G4ThreeVector(x_in_glue,0., zSiPM), rot),
-                    siPMLogic, "SiPM"+suffix, mother, false, 0, true);
-
-    // --- (E) 경계 마감 (polished: Fresnel만) ---
-    auto polishedInt = new G4OpticalSurface("IntPolished"+suffix);
-    polishedInt->SetType(dielectric_dielectric);
-    polishedInt->SetModel(unified);
-    polishedInt->SetFinish(polished);
-
-    // Scint ↔ Glue (groove 표면)
-    auto surfScintGlue = new G4OpticalSurface("SurfScintGlue"+suffix);
-    surfScintGlue->SetType(dielectric_dielectric);
-    surfScintGlue->SetModel(unified);
-    surfScintGlue->SetFinish(polished);
-    new G4LogicalBorderSurface("BScintGlue"+suffix, scintPV, gluePV, surfScintGlue);
-
-    // Clad ↔ Coupling
-    new G4LogicalBorderSurface("Border_Clad_Coupling"+suffix, cladPV, coupPV, polishedInt);
-    // Coupling ↔ SiPM
-    new G4LogicalBorderSurface("Border_Coupling_SiPM"+suffix, coupPV, sipmPV, polishedInt);
+    new G4PVPlacement(rot,
+                      pos + ApplyRot(grooveShift + G4ThreeVector(x_in_glue,0., zSiPM), rot),
+                      siPMLogic, "SiPM"+suffix, mother, false, 0, true);
+
+    // 컷 전용 영역: 글루, 파이버 돌출부, coupling, SiPM (컷값은 PhysicsList)
+    //  FiberRegion(안쪽 clad) 과 함께 "fiber" 컷 묶음
+    auto readoutRegion = G4RegionStore::GetInstance()->FindOrCreateRegion("ReadoutRegion");
+    readoutRegion->AddRootLogicalVolume(glueLV);
+    readoutRegion->AddRootLogicalVolume(coupLV);
+    readoutRegion->AddRootLogicalVolume(siPMLogic);
+    for (std::size_t i = 2; i < fiberLVs.size(); i += 2)
+      readoutRegion->AddRootLogicalVolume(fiberLVs[i]);
+
+    // --- (E) 경계 마감 ---
+    //  Scint ↔ Glue, Clad ↔ Coupling, Coupling ↔ SiPM 은 polished (Fresnel 만)
+    //  → 표면을 정의하지 않음 (물성 없는 polished 표면과 같은 처리)
+    auto surfaces = OpticalSurfaceRegistry::Instance();
 
     // --- (F) Teflon wrapping (확산 반사) ---
-    G4double t=0.01*mm, margin=0.001*mm;
-    auto teflonOptSurface = new G4OpticalSurface("TeflonSurface"+suffix);
-    teflonOptSurface->SetType(dielectric_dielectric);
-    teflonOptSurface->SetModel(unified);
-    teflonOptSurface->SetFinish(groundfrontpainted);
-
-    auto teflonMPT = new G4MaterialPropertiesTable();
-    G4double reflectivity[NUMENTRIES]; for (int i=0;i<NUMENTRIES;i++) reflectivity[i]=0.98;
-    teflonMPT->AddProperty("REFLECTIVITY",photonEnergy,reflectivity,NUMENTRIES);
-    teflonOptSurface->SetMaterialPropertiesTable(teflonMPT);
-
-    auto boxBottom = new G4Box("TeflonBottom"+suffix, halfX+t, halfY+t, t/2);
-    auto logicTeflonBottom = new G4LogicalVolume(boxBottom, teflonMat, "TeflonBottom"+suffix);
-    new G4PVPlacement(rot, pos + ApplyRot(G4ThreeVector(0,0,-(halfZ+t/2)), rot),
-                      logicTeflonBottom,"TeflonBottom"+suffix,mother,false,0,true);
-    new G4LogicalSkinSurface("SurfBottom"+suffix,logicTeflonBottom,teflonOptSurface);
-
-    auto boxSideX = new G4Box("TeflonSideX"+suffix, t/2, halfY+t - margin, halfZ - siPMThick - margin);
-    auto logicTeflonLeft = new G4LogicalVolume(boxSideX, teflonMat, "TeflonLeft"+suffix);
-    new G4PVPlacement(rot, pos + ApplyRot(G4ThreeVector(-(halfX + t/2),0,0), rot),
-                      logicTeflonLeft,"TeflonLeft"+suffix,mother,false,0,true);
-    new G4LogicalSkinSurface("SurfLeft"+suffix,logicTeflonLeft,teflonOptSurface);
-
-    auto boxSideX2 = new G4Box("TeflonSideX2"+suffix, t/2, halfY+t - margin, halfZ - siPMThick - margin);
-    auto logicTeflonRight = new G4LogicalVolume(boxSideX2, teflonMat, "TeflonRight"+suffix);
-    new G4PVPlacement(rot, pos + ApplyRot(G4ThreeVector(+(halfX + t/2),0,0), rot),
-                      logicTeflonRight,"TeflonRight"+suffix,mother,false,0,true);
-    new G4LogicalSkinSurface("SurfRight"+suffix,logicTeflonRight,teflonOptSurface);
-
-    auto boxSideY = new G4Box("TeflonSideY"+suffix, (halfX) - margin, t/2, halfZ - siPMThick - margin);
-    auto logicTeflonFront = new G4LogicalVolume(boxSideY, teflonMat, "TeflonFront"+suffix);
-    new G4PVPlacement(rot, pos + ApplyRot(G4ThreeVector(0,-(halfY + t/2),0), rot),
-                      logicTeflonFront,"TeflonFront"+suffix,mother,false,0,true);
-    new G4LogicalSkinSurface("SurfFront"+suffix,logicTeflonFront,teflonOptSurface);
-
-    auto boxSideY2 = new G4Box("TeflonSideY2"+suffix, (halfX) - margin, t/2, halfZ - siPMThick - margin);
-    auto logicTeflonBack = new G4LogicalVolume(boxSideY2, teflonMat, "TeflonBack"+suffix);
-    new G4PVPlacement(rot, pos + ApplyRot(G4ThreeVector(0,+(halfY + t/2),0), rot),
-                      logicTeflonBack,"TeflonBack"+suffix,mother,false,0,true);
-    new G4LogicalSkinSurface("SurfBack"+suffix,logicTeflonBack,teflonOptSurface);
+    //  치수가 같은 좌/우, 앞/뒤 판은 LV 하나를 두 번 배치 → skin surface 3개
+    G4double t=fWrapThickness, margin=0.001*mm;
+    auto teflonMPT = surfaces->GetConstantPropertyTable("REFLECTIVITY", fWrapReflectivity, fPhotonEnergies);
+    auto teflonOptSurface = surfaces->GetSurface("TeflonSurface", dielectric_dielectric,
+                                                 unified, groundfrontpainted, teflonMPT);
+    fTeflonSurface = teflonOptSurface;
+
+    if (fWrappingMode == kSurfaceWrap) {
+      // 표면만: 신틸 skin 전체를 반사면으로 (포장판 없음 → -Z, ±X, ±Y 와 +Z 면 모두).
+      //  groove 안쪽 면은 빈 MPT 를 가진 polished border surface 로 덮어
+      //  (border 가 skin 보다 우선) 기존처럼 Fresnel 만 적용.
+      //  groove/glue/파이버의 +X, -Z 면 (판 포장에서는 판이 덮음) 은 envelope 와 맞닿으므로
+      //  세그먼트 배치 후 (envelope PV 가 생긴 뒤) 같은 테플론 border surface 를 붙임.
+      //  (glue 의 +Z 면도 함께 덮임 — 신틸 +Z 면과 같은 처리)
+      surfaces->AddSkinSurface("SurfScintWrap"+suffix, logicScint, teflonOptSurface);
+      auto grooveClear = surfaces->GetSurface("GrooveClear", dielectric_dielectric, unified, polished,
+                                              new G4MaterialPropertiesTable());
+      surfaces->AddBorderSurface("BScintGroove"+suffix, scintPV, groovePV, grooveClear);
+      surfaces->AddBorderSurface("BGrooveScint"+suffix, groovePV, scintPV, grooveClear);
+    } else {
+      auto boxBottom = new G4Box("TeflonBottom"+suffix, halfX+t, halfY+t, t/2);
+      auto logicTeflonBottom = new G4LogicalVolume(boxBottom, teflonMat, "TeflonBottom"+suffix);
+      new G4PVPlacement(rot, pos + ApplyRot(G4ThreeVector(0,0,-(halfZ+t/2)), rot),
+                        logicTeflonBottom,"TeflonBottom"+suffix,mother,false,0,true);
+      surfaces->AddSkinSurface("SurfBottom"+suffix,logicTeflonBottom,teflonOptSurface);
+
+      auto boxSideX = new G4Box("TeflonSideX"+suffix, t/2, halfY+t - margin, halfZ - siPMThick - margin);
+      auto logicTeflonSideX = new G4LogicalVolume(boxSideX, teflonMat, "TeflonSideX"+suffix);
+      new G4PVPlacement(rot, pos + ApplyRot(G4ThreeVector(-(halfX + t/2),0,0), rot),
+                        logicTeflonSideX,"TeflonLeft"+suffix,mother,false,0,true);
+      new G4PVPlacement(rot, pos + ApplyRot(G4ThreeVector(+(halfX + t/2),0,0), rot),
+                        logicTeflonSideX,"TeflonRight"+suffix,mother,false,1,true);
+      surfaces->AddSkinSurface("SurfSideX"+suffix,logicTeflonSideX,teflonOptSurface);
+
+      auto boxSideY = new G4Box("TeflonSideY"+suffix, (halfX) - margin, t/2, halfZ - siPMThick - margin);
+      auto logicTeflonSideY = new G4LogicalVolume(boxSideY, teflonMat, "TeflonSideY"+suffix);
+      new G4PVPlacement(rot, pos + ApplyRot(G4ThreeVector(0,-(halfY + t/2),0), rot),
+                        logicTeflonSideY,"TeflonFront"+suffix,mother,false,0,true);
+      new G4PVPlacement(rot, pos + ApplyRot(G4ThreeVector(0,+(halfY + t/2),0), rot),
+                        logicTeflonSideY,"TeflonBack"+suffix,mother,false,1,true);
+      surfaces->AddSkinSurface("SurfSideY"+suffix,logicTeflonSideY,teflonOptSurface);
+
+      auto passiveRegion = G4RegionStore::GetInstance()->FindOrCreateRegion("PassiveRegion");
+      for (auto lv : {logicTeflonBottom, logicTeflonSideX, logicTeflonSideY})
+        passiveRegion->AddRootLogicalVolume(lv);
+    }
   };
 
-  // ---- 단일 세트 배치 ----
-  BuildScintSet(logicWorld, G4ThreeVector(0,0,0), nullptr, "_BVH1");
+  // ---- 세그먼트 한 세트를 envelope 안에 한 번만 생성 ----
+  //  (solid / LV / 표면 / vis 속성 공유, 신틸 중심 = envelope 원점에서 -envZc)
+  auto solidSegment = new G4Box("Segment", envHalfX, envHalfY, 0.5*(envZmax - envZmin));
+  fSegmentLV = new G4LogicalVolume(solidSegment, worldMat, "SegmentLV");
+  fSegmentLV->SetVisAttributes(G4VisAttributes::GetInvisible());
+  BuildScintSet(fSegmentLV, G4ThreeVector(0,0,-envZc), nullptr, "_BVH1");
+
+  // ---- N×M 배치 (copy number = layer*columns + column) ----
+  const G4double rssBeforePlacement = ResourceUsage::ResidentMemoryMB();
+  G4Timer placementTimer;
+  placementTimer.Start();
+  for (G4int copyNo = 0; copyNo < GetNumberOfSegments(); copyNo++) {
+    auto segmentPV = new G4PVPlacement(nullptr, GetSegmentPosition(copyNo) + G4ThreeVector(0,0,envZc),
+                                       fSegmentLV, "Segment", logicWorld, false, copyNo, fCheckOverlaps);
+    // surface 포장: border 는 (볼륨, envelope PV) 쌍 → 배치마다 하나씩.
+    //  groundfrontpainted 는 투과가 없으므로 envelope → 볼륨 방향은 필요 없음
+    for (auto pv : wrapExitPVs)
+      OpticalSurfaceRegistry::Instance()->AddBorderSurface(pv->GetName() + "_Wrap", pv, segmentPV,
+                                                           fTeflonSurface);
+  }
+  placementTimer.Stop();
+  initTimer.Stop();
+
+  const G4double rssEnd = ResourceUsage::ResidentMemoryMB();
+  const G4int nSeg = GetNumberOfSegments();
+  G4cout << "[Array] " << fNLayers << " x " << fNColumns << " = " << nSeg << " segments"
+         << " | init " << initTimer.GetRealElapsed()*1000. << " ms"
+         << " (placement " << placementTimer.GetRealElapsed()*1000. << " ms)"
+         << " | RSS " << rssEnd << " MB, +" << (rssEnd - rssStart) << " MB total, "
+         << (rssEnd - rssBeforePlacement)*1024./nSeg << " kB/segment" << G4endl;
+
+  OpticalSurfaceRegistry::Instance()->Report();
+  if (fWrapTable) SetWrapModel("table");
 
   logicWorld->SetVisAttributes(G4VisAttributes::GetInvisible());
   return physWorld;
 }
+
+// =========================================================
+//  SiPM SD + Fast-simulation 모델 (스레드별)
+// =========================================================
+void DetectorConstruction::ConstructSDandField() {
+  // SD 는 스레드 지역 (워커마다 자기 SD/hit 수집). 형상 재구성 시 기존 SD 재사용
+  auto siPMSD = G4SDManager::GetSDMpointer()->FindSensitiveDetector("SiPMSD", false);
+  if (!siPMSD) {
+    siPMSD = new SiPMSensitiveDetector("SiPMSD");
+    G4SDManager::GetSDMpointer()->AddNewDetector(siPMSD);
+  }
+  for (const auto& name : fSiPMLVNames) SetSensitiveDetector(name, siPMSD);
+
+  // 형상 재구성 때도 영역은 유지 → 모델이 이미 있으면 그대로 사용
+  auto fiberRegion = G4RegionStore::GetInstance()->GetRegion("FiberRegion", false);
+  if (fiberRegion && !fiberRegion->GetFastSimulationManager())
+    new FiberTransportModel("FiberTransportModel", fiberRegion);
+
+  auto segmentRegion = G4RegionStore::GetInstance()->GetRegion("SegmentRegion", false);
+  if (segmentRegion && !segmentRegion->GetFastSimulationManager())
+    new SegmentResponseModel("SegmentResponseModel", segmentRegion);
+}
+
+void DetectorConstruction::DefineCommands() {
+  fFiberMessenger = new G4GenericMessenger(this, "/veto/fiber/", "Fiber transport fast simulation");
+  fFiberMessenger->DeclareMethod("fastSim", &DetectorConstruction::SetFiberFastSim,
+                                 "Parametrized transport of trapped photons in the fiber core")
+    .SetToBeBroadcasted(false);
+  fFiberMessenger->DeclareMethod("endReflectivity", &DetectorConstruction::SetFiberEndReflectivity,
+                                 "Reflectivity of the fiber -Z end (teflon)")
+    .SetToBeBroadcasted(false);
+
+  fScintMessenger = new G4GenericMessenger(this, "/veto/scint/", "Scintillator settings");
+  auto& scanCmd = fScintMessenger->DeclareMethod("yieldScan", &DetectorConstruction::SetYieldScan,
+                                 "Yield points in 1/MeV for a single-pass thinning scan (empty = off)");
+  scanCmd.SetParameterName("yields", true);
+  scanCmd.SetDefaultValue("");
+  scanCmd.SetToBeBroadcasted(false);
+
+  fArrayMessenger = new G4GenericMessenger(this, "/veto/array/", "Segment array layout (before /run/initialize)");
+  fArrayMessenger->DeclareProperty("columns", fNColumns, "Number of segments along Y")
+    .SetParameterName("n", false).SetRange("n>0").SetToBeBroadcasted(false);
+  fArrayMessenger->DeclareProperty("layers", fNLayers, "Number of segment layers along X")
+    .SetParameterName("n", false).SetRange("n>0").SetToBeBroadcasted(false);
+  fArrayMessenger->DeclarePropertyWithUnit("pitchX", "mm", fPitchX, "Layer pitch (0 = packed)")
+    .SetToBeBroadcasted(false);
+  fArrayMessenger->DeclarePropertyWithUnit("pitchY", "mm", fPitchY, "Column pitch (0 = packed)")
+    .SetToBeBroadcasted(false);
+  fArrayMessenger->DeclareProperty("checkOverlaps", fCheckOverlaps,
+                                   "Overlap check for each segment placement (slow for large arrays)")
+    .SetToBeBroadcasted(false);
+  fArrayMessenger->DeclareMethod("writeChannelMap", &DetectorConstruction::WriteChannelMap,
+                                 "Write channel -> layer/column/SiPM position table")
+    .SetToBeBroadcasted(false);
+
+  fSurfaceMessenger = new G4GenericMessenger(this, "/veto/surface/", "Optical surface registry");
+  fSurfaceMessenger->DeclareMethod("wrapModel", &DetectorConstruction::SetWrapModel,
+                                   "Teflon reflection: analytic (unified groundfrontpainted) | table (lookup)")
+    .SetCandidates("analytic table").SetToBeBroadcasted(false);
+  fSurfaceMessenger->DeclareMethod("wrapTable", &DetectorConstruction::LoadWrapTable,
+                                   "Load a measured teflon reflectance / angular table")
+    .SetToBeBroadcasted(false);
+  fSurfaceMessenger->DeclareMethod("writeWrapTable", &DetectorConstruction::WriteWrapTable,
+                                   "Write the current teflon lookup table")
+    .SetToBeBroadcasted(false);
+  fSurfaceMessenger->DeclareMethod("wrapBenchmark", &DetectorConstruction::BenchmarkWrapTable,
+                                   "Reflections per second: analytic vs table sampling")
+    .SetToBeBroadcasted(false);
+
+  fGeometryMessenger = new G4GenericMessenger(this, "/veto/geometry/", "Scintillator/glue construction");
+  fGeometryMessenger->DeclareMethod("mode", &DetectorConstruction::SetGeometryMode,
+                                    "boolean | nested (before /run/initialize)")
+    .SetCandidates("boolean nested").SetToBeBroadcasted(false);
+  fGeometryMessenger->DeclareMethod("wrapping", &DetectorConstruction::SetWrappingMode,
+                                    "slabs | surface (teflon as volumes or as scintillator surface only)")
+    .SetCandidates("slabs surface").SetToBeBroadcasted(false);
+  fGeometryMessenger->DeclareMethod("benchmark", &DetectorConstruction::BenchmarkNavigation,
+                                    "Random-ray navigation and solid call timing")
+    .SetToBeBroadcasted(false);
+}
+
+void DetectorConstruction::SetGeometryMode(const G4String& mode) {
+  fGeometryMode = (mode == "nested") ? kNested : kBoolean;
+}
+
+void DetectorConstruction::SetWrappingMode(const G4String& mode) {
+  fWrappingMode = (mode == "surface") ? kSurfaceWrap : kSlabWrap;
+}
+
+// =========================================================
+//  Navigation micro-benchmark
+//   (1) 0번 세그먼트 bounding box 안 무작위 점 + 등방 방향 광선을
+//       envelope 밖으로 나갈 때까지 G4Navigator 로 추적
+//   (2) 신틸 solid 의 Inside / DistanceToIn / DistanceToOut 직접 호출
+//   광선은 고정 시드 지역 엔진으로 미리 만들어 둠 → 두 모드가 같은 광선,
+//   전역 난수 상태 그대로, 난수 생성은 측정 밖.  시간은 이 스레드의 CPU 시간
+// =========================================================
+void DetectorConstruction::BenchmarkNavigation(G4int nRays) {
+  auto world = G4TransportationManager::GetTransportationManager()
+                   ->GetNavigatorForTracking()->GetWorldVolume();
+  if (!world || !fScintillatorLV || nRays <= 0) {
+    G4cout << "[Navigation] geometry not initialized." << G4endl;
+    return;
+  }
+
+  G4Navigator navigator;
+  navigator.SetWorldVolume(world);
+
+  CLHEP::MixMaxRng engine(20240611);
+  CLHEP::RandFlat flat(engine);
+  auto RandomDirection = [&]() {
+    G4double cost = 1 - 2*flat.fire(), sint = std::sqrt(1 - cost*cost);
+    G4double phi = CLHEP::twopi*flat.fire();
+    return G4ThreeVector(sint*std::cos(phi), sint*std::sin(phi), cost);
+  };
+
+  const G4ThreeVector origin = GetSegmentPosition(0);
+  const G4ThreeVector half(GetEnvelopeHalfX(), fScintY/2, fScintZ/2);
+  std::vector<G4ThreeVector> rayPoints(nRays), rayDirs(nRays);
+  for (G4int n = 0; n < nRays; n++) {
+    rayPoints[n] = origin + G4ThreeVector((2*flat.fire()-1)*half.x(),
+                                          (2*flat.fire()-1)*half.y(),
+                                          (2*flat.fire()-1)*half.z());
+    rayDirs[n] = RandomDirection();
+  }
+
+  auto solid = fScintillatorLV->GetSolid();
+  G4ThreeVector pMin, pMax;
+  solid->BoundingLimits(pMin, pMax);
+  std::vector<G4ThreeVector> solidPoints(nRays), solidDirs(nRays);
+  for (G4int n = 0; n < nRays; n++) {
+    solidPoints[n].set(pMin.x() + flat.fire()*(pMax.x() - pMin.x()),
+                       pMin.y() + flat.fire()*(pMax.y() - pMin.y()),
+                       pMin.z() + flat.fire()*(pMax.z() - pMin.z()));
+    solidDirs[n] = RandomDirection();
+  }
+
+  // (1) 광선 추적
+  long nSteps = 0;
+  G4double cpu0 = ResourceUsage::ThreadCpuSeconds();
+  for (G4int n = 0; n < nRays; n++) {
+    G4ThreeVector p = rayPoints[n], v = rayDirs[n];
+    navigator.LocateGlobalPointAndSetup(p, &v, false, false);
+    for (G4int k = 0; k < 100; k++) {
+      G4double safety = 0.;
+      G4double step = navigator.ComputeStep(p, v, kInfinity, safety);
+      if (step == kInfinity) break;
+      p += step*v;
+      nSteps++;
+      navigator.SetGeometricallyLimitedStep();
+      auto pv = navigator.LocateGlobalPointAndSetup(p, &v, true, false);
+      if (!pv || pv == world) break;
+    }
+  }
+  G4double rayTime = ResourceUsage::ThreadCpuSeconds() - cpu0;
+
+  // (2) 신틸 solid 호출
+  G4int nInside = 0;
+  G4double sum = 0.;
+  cpu0 = ResourceUsage::ThreadCpuSeconds();
+  for (G4int n = 0; n < nRays; n++) {
+    const G4ThreeVector& p = solidPoints[n];
+    const G4ThreeVector& v = solidDirs[n];
+    if (solid->Inside(p) == kInside) { nInside++; sum += solid->DistanceToOut(p, v); }
+    else sum += std::min(solid->DistanceToIn(p, v), 1.*m);
+  }
+  G4double solidTime = ResourceUsage::ThreadCpuSeconds() - cpu0;
+
+  G4cout << "[Navigation] mode " << (fGeometryMode == kNested ? "nested" : "boolean")
+         << " | " << nRays << " rays, " << G4double(nSteps)/nRays << " steps/ray, "
+         << rayTime*1e9/std::max(nSteps, 1L) << " ns/step, "
+         << rayTime*1e6/nRays << " us/ray"
+         << " | scint solid (" << solid->GetEntityType() << ") "
+         << solidTime*1e9/nRays << " ns/call set"
+         << " (inside " << G4double(nInside)/nRays << ", checksum " << sum/nRays << ")"
+         << " [thread CPU]" << G4endl;
+}
+
+// 테이블은 표면 생성 뒤에만 대상 지정 가능 → 초기화 전이면 Construct 끝에서 다시 호출
+//  경계 프로세스 교체는 물리 구성 때 결정 → 테이블 모드는 /run/initialize 전에 선택
+void DetectorConstruction::SetWrapModel(const G4String& model) {
+  auto table = WrapReflectanceTable::Instance();
+  if (model == "table" && !table->IsRequested()) {
+    if (G4StateManager::GetStateManager()->GetCurrentState() != G4State_PreInit) {
+      G4cout << "[WrapTable] select the table model before /run/initialize; staying analytic." << G4endl;
+      return;
+    }
+    table->SetRequested(true);
+  }
+  fWrapTable = (model == "table");
+  if (!fWrapTable || !fTeflonSurface) {
+    table->SetTarget(nullptr);
+    return;
+  }
+  if (!table->IsLoaded() || !table->IsMeasured()) table->BuildFromSurface(fTeflonSurface);
+  table->SetTarget(fTeflonSurface);
+}
+
+// ---------------------------------------------------------
+//  스캔 파라미터 (ParameterScan): 형상 값은 다음 /run/beamOn 전 형상 재구성 필요
+// ---------------------------------------------------------
+G4bool DetectorConstruction::SetFiberDesign(G4double groove, G4double radius,
+                                            G4double fiberZ, G4double coupling) {
+  // 파이버 + glue 공기막이 groove 에 들어가야 함
+  if (radius <= 0. || groove < 2*radius + 0.02*mm || groove > fScintX) return false;
+  // 파이버가 신틸 전체 길이를 지나야 함 (-Z 끝은 신틸 -Z 면 밖으로 나가지 않음)
+  if (fiberZ - fFiberLength/2 < -fScintZ/2 - 1e-9*mm || fiberZ + fFiberLength/2 <= fScintZ/2) return false;
+  if (coupling <= 0.) return false;
+  fGrooveSize = groove;
+  fFiberCladRadius = radius;
+  fFiberZCenter = fiberZ;
+  fCouplingThickness = coupling;
+  return true;
+}
+
+// 반사율은 표면 MPT 만 바꿈 (형상/물리 테이블 유지)
+void DetectorConstruction::SetWrapReflectivity(G4double r) {
+  fWrapReflectivity = r;
+  if (!fTeflonSurface || fPhotonEnergies.empty()) return;
+  fTeflonSurface->SetMaterialPropertiesTable(
+    OpticalSurfaceRegistry::Instance()->GetConstantPropertyTable("REFLECTIVITY", r, fPhotonEnergies));
+  if (fWrapTable) SetWrapModel("table");
+}
+
+void DetectorConstruction::LoadWrapTable(const G4String& fileName) {
+  if (WrapReflectanceTable::Instance()->Read(fileName))
+    G4cout << "[WrapTable] loaded " << fileName << G4endl;
+  else
+    G4cout << "[WrapTable] failed to read " << fileName << G4endl;
+}
+
+void DetectorConstruction::WriteWrapTable(const G4String& fileName) {
+  if (WrapReflectanceTable::Instance()->Write(fileName))
+    G4cout << "[WrapTable] written to " << fileName << G4endl;
+  else
+    G4cout << "[WrapTable] nothing to write (no table)" << G4endl;
+}
+
+void DetectorConstruction::BenchmarkWrapTable(G4int nReflections) {
+  WrapReflectanceTable::Instance()->Benchmark(nReflections);
+}
+
+void DetectorConstruction::SetFiberFastSim(G4bool on) {
+  FiberTransportModel::SetEnabled(on);
+}
+
+void DetectorConstruction::SetFiberEndReflectivity(G4double r) {
+  FiberTransportModel::SetEndReflectivity(r);
+}
+
+void DetectorConstruction::SetYieldScan(const G4String& yields) {
+  std::vector<G4double> list;
+  std::istringstream is(yields);
+  G4double y;
+  while (is >> y) if (y > 0.) list.push_back(y/MeV);
+  YieldScan::SetYields(list);
+  if (list.empty()) G4cout << "[YieldScan] off" << G4endl;
+  else G4cout << "[YieldScan] " << list.size() << " yield points, simulating at "
+              << YieldScan::GetMaxYield()*MeV << " /MeV" << G4endl;
+}
@@ -0,0 +1,31 @@
+#include "EfficiencyMode.hh"
+
+#include "G4GenericMessenger.hh"
+
+EfficiencyMode::Mode EfficiencyMode::fMode = EfficiencyMode::kOff;
+G4int                EfficiencyMode::fThreshold = 2;
+
+EfficiencyMode::EfficiencyMode()
+{
+    DefineCommands();
+}
+
+EfficiencyMode::~EfficiencyMode()
+{
+    delete fMessenger;
+}
+
+void EfficiencyMode::DefineCommands()
+{
+    fMessenger = new G4GenericMessenger(this, "/veto/efficiency/", "Threshold-aware early event termination");
+    fMessenger->DeclareMethod("mode", &EfficiencyMode::SetMode,
+                              "off | on (abort optical photons over threshold) | validate (flag only, measure CPU)")
+        .SetCandidates("off on validate").SetToBeBroadcasted(false);
+    fMessenger->DeclareProperty("threshold", fThreshold, "Threshold in detected photoelectrons")
+        .SetParameterName("n", false).SetRange("n>0").SetToBeBroadcasted(false);
+}
+
+void EfficiencyMode::SetMode(const G4String& mode)
+{
+    fMode = (mode == "on") ? kOn : (mode == "validate") ? kValidate : kOff;
+}
@@ -1,7 +1,22 @@
 #include "EventAction.hh"
 #include "RunAction.hh"
+#include "SiPMSensitiveDetector.hh"
+#include "ResponseTableBuilder.hh"
+#include "YieldScan.hh"
+#include "BeamScan.hh"
+#include "AdaptiveRun.hh"
+#include "EfficiencyMode.hh"
+#include "ResourceUsage.hh"
 #include "G4Event.hh"
+#include "G4EventManager.hh"
+#include "G4Track.hh"
+#include "G4VProcess.hh"
+#include "G4StackManager.hh"
 #include "G4SystemOfUnits.hh"
+#include "CLHEP/Units/PhysicalConstants.h"
+#include "Randomize.hh"
+
+#include <algorithm>
 
 EventAction::EventAction(RunAction* runAction)
     : G4UserEventAction(),
@@ -17,22 +32,124 @@ void EventAction::BeginOfEventAction(const G4Event*) {
     fPhotonCount = 0;
     fEnergyDeposit = 0;
     fWavelengths.clear();
+    fHitTimes.clear();
+    fThinKeys.clear();
+    fUnthinned = 0;
+    fScintOrigin.clear();
+    fPhotonPaths.clear();
+    fPhaseSpace.clear();
+    fLibraryHits.clear();
+    fOpticalSteps = 0;
+    fOpticalTracks = 0;
+    fPhotonEngine.Clear();
+    fOverThreshold = false;
+    fPeakStackDepth = 0;
+    fPhotonStageFull = false;
+    if (EfficiencyMode::IsActive()) fEventCpuStart = ResourceUsage::ThreadCpuSeconds();
+
+    // 발화한 채널 슬롯만 되돌림
+    for (auto ch : fFiredChannels) fChannelSlot[ch] = -1;
+    fFiredChannels.clear();
+    fChannelNpe.clear();
+    fChannelFirstTime.clear();
+    fChannelWlSum.clear();
+    fChannelWlSum2.clear();
+    fChannelWlN.clear();
 }
 
-void EventAction::EndOfEventAction(const G4Event*) {
+void EventAction::EndOfEventAction(const G4Event* event) {
+    // 배치 엔진: 모은 genstep 전파 → SiPM 도달 광자 처리
+    if (PhotonBatchEngine::CollectsGensteps()) {
+        fArrivals.clear();
+        fPhotonEngine.Propagate(fArrivals);
+        if (fRunAction)
+            fRunAction->AddBatchedPhotons(fPhotonEngine.GetNumberOfPropagated(),
+                                          fPhotonEngine.GetNumberOfTruncated());
+
+        if (PhotonBatchEngine::GetMode() == PhotonBatchEngine::kBatched) {
+            // Geant4 SiPM 검출 경로와 동일하게 기록 (엔진은 신틸레이션 광자만 전파)
+            for (const auto& a : fArrivals)
+                SiPMSensitiveDetector::RecordPhoton(a.energy, a.time, nullptr, a.segment, true);
+        } else if (fRunAction) {
+            // 검증 모드: Geant4 결과와 별도로 집계
+            G4int nBatched = 0;
+            for (const auto& a : fArrivals) {
+                G4double wl = (CLHEP::h_Planck * CLHEP::c_light / a.energy) / nm;
+                if (G4UniformRand() < SiPMSensitiveDetector::GetPDE(wl)) nBatched++;
+            }
+            fRunAction->FillNpeBatched(nBatched);
+        }
+    }
+
+    // 목표 정밀도 런: 합산 + 수렴 시 이 스레드 중단
+    if (AdaptiveRun::IsActive()) AdaptiveRun::RecordEvent(fPhotonCount);
+
+    // 응답 테이블 생성 중이면 이벤트 결과 수집
+    if (ResponseTableBuilder::IsCollecting() && fRunAction)
+        fRunAction->FillResponse(fPhotonCount, fHitTimes);
+
     // RunAction에 이벤트 결과 전달
     fRunAction->AddPhotonCount(fPhotonCount);
     fRunAction->AddEnergyDeposit(fEnergyDeposit);
+    fRunAction->AddOpticalSteps(fOpticalSteps, fOpticalTracks);
+    fRunAction->AddStackDepth(fPeakStackDepth);
+    if (EfficiencyMode::IsActive()) {
+        const G4double cpu = ResourceUsage::ThreadCpuSeconds();
+        fRunAction->AddEfficiencyEvent(fOverThreshold, cpu - fEventCpuStart,
+                                       fOverThreshold ? cpu - fThresholdCpu : 0.);
+    }
+    if (fPrimaryRate > 0.) fRunAction->AddPrimaryRate(fPrimaryRate, fPhotonCount > 0);
+    if (PhaseSpace::IsRecording())
+        PhaseSpace::WriteEvent(event->GetEventID(), fPhaseSpace, fPrimaryRate > 0.);
+    if (EventLibrary::IsRecording())
+        EventLibrary::WriteEvent(fLibraryHits, fPrimaryRate > 0. ? fPrimaryRate*s : 1., fPrimaryRate > 0.);
+    fPrimaryRate = 0.;
 
     // 파장 정보 전달 (RunAction에서 히스토그램에 채움)
     if (fRunAction) {
         fRunAction->FillWavelengths(fWavelengths);
         fRunAction->FillNpe(fPhotonCount);
+
+        // 광량 스캔: 최대 광량에서 검출된 광자를 키로 thinning
+        if (YieldScan::IsActive()) {
+            YieldScan::Thin(fThinKeys, fUnthinned, fScanNpe);
+            fRunAction->FillNpeScan(fScanNpe);
+        }
+
+        if (RecordsPhotonPaths()) fRunAction->FillPhotonPaths(fPhotonCount, fPhotonPaths);
+
+        if (BeamScan::IsActive()) {
+            G4double firstTime = fHitTimes.empty() ? 0.
+                               : *std::min_element(fHitTimes.begin(), fHitTimes.end());
+            fRunAction->FillBeamScan(event->GetEventID() / BeamScan::GetEventsPerPoint(),
+                                     fPhotonCount, firstTime);
+        }
+
+        for (std::size_t k = 0; k < fFiredChannels.size(); k++)
+            fRunAction->FillChannel(fFiredChannels[k], fChannelNpe[k], fChannelFirstTime[k],
+                                    fChannelWlSum[k], fChannelWlSum2[k], fChannelWlN[k]);
     }
 }
 
-void EventAction::AddPhoton() {
+void EventAction::AddPhoton(G4bool scintOrigin) {
     fPhotonCount++;
+    if (!YieldScan::IsActive()) return;
+    if (scintOrigin) fThinKeys.push_back(G4UniformRand());
+    else fUnthinned++;
+}
+
+// 트랙 ID 는 이벤트 안에서 증가, 부모는 자식보다 먼저 추적됨
+void EventAction::MarkPhotonOrigin(const G4Track* track) {
+    const G4int id = track->GetTrackID();
+    if (id >= G4int(fScintOrigin.size())) fScintOrigin.resize(2*id + 1, 0);
+    auto creator = track->GetCreatorProcess();
+    char scint = 0;
+    if (creator) {
+        const G4String& name = creator->GetProcessName();
+        if (name == "Scintillation") scint = 1;
+        else if (name != "Cerenkov") scint = IsScintillationPhoton(track->GetParentID());
+    }
+    fScintOrigin[id] = scint;
 }
 
 void EventAction::AddEnergyDeposit(G4double energy) {
@@ -43,6 +160,55 @@ void EventAction::AddWavelength(G4double wavelength) {
     fWavelengths.push_back(wavelength);
 }
 
+void EventAction::AddHitTime(G4double time) {
+    fHitTimes.push_back(time);
+}
+
+// 채널 → 발화 목록 위치 (처음 발화할 때 슬롯 추가)
+void EventAction::AddChannelHit(G4int channel, G4double time, G4double wavelength) {
+    if (channel < 0) channel = 0;
+    if (channel >= G4int(fChannelSlot.size())) fChannelSlot.resize(channel + 1, -1);
+    G4int slot = fChannelSlot[channel];
+    if (slot < 0) {
+        slot = fChannelSlot[channel] = fFiredChannels.size();
+        fFiredChannels.push_back(channel);
+        fChannelNpe.push_back(0);
+        fChannelFirstTime.push_back(time);
+        fChannelWlSum.push_back(0.);
+        fChannelWlSum2.push_back(0.);
+        fChannelWlN.push_back(0);
+    }
+    fChannelNpe[slot]++;
+    if (EventLibrary::IsRecording())
+        fLibraryHits.push_back({uint32_t(channel), float(time/ns)});
+    fChannelFirstTime[slot] = std::min(fChannelFirstTime[slot], time);
+    if (wavelength > 0.) {
+        fChannelWlSum[slot]  += wavelength;
+        fChannelWlSum2[slot] += wavelength*wavelength;
+        fChannelWlN[slot]++;
+    }
+}
+
+void EventAction::MarkOverThreshold() {
+    fOverThreshold = true;
+    fThresholdCpu = ResourceUsage::ThreadCpuSeconds();
+    // 이미 스택에 있는 광학 광자를 StackingAction 으로 다시 분류 (→ fKill)
+    if (EfficiencyMode::AbortsPhotons())
+        G4EventManager::GetEventManager()->GetStackManager()->ReClassify();
+}
+
+void EventAction::AddGenstep(const PhotonBatchEngine::Genstep& gs) {
+    fPhotonEngine.AddGenstep(gs);
+}
+
+void EventAction::AddPhotonPath(const PhotonTrackInformation& info) {
+    fPhotonPaths.push_back(info);
+}
+
+G4bool EventAction::RecordsPhotonPaths() const {
+    return fRunAction && fRunAction->RecordsPhotonPaths();
+}
+
 G4int EventAction::GetPhotonCount() const {
     return fPhotonCount;
 }
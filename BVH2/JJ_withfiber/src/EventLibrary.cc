@@ -0,0 +1,119 @@
+#include "EventLibrary.hh"
+
+#include "G4GenericMessenger.hh"
+#include "G4AutoLock.hh"
+
+#include <algorithm>
+#include <cstring>
+
+std::ofstream         EventLibrary::fOut;
+G4String              EventLibrary::fOutName = "library.bin";
+std::vector<uint64_t> EventLibrary::fOffsets;
+uint64_t              EventLibrary::fEnd = 0;
+uint64_t              EventLibrary::fNHits = 0;
+uint32_t              EventLibrary::fNChannels = 0;
+uint32_t              EventLibrary::fFlags = 0;
+
+namespace {
+    G4Mutex libraryMutex = G4MUTEX_INITIALIZER;
+    const char        kMagic[4]   = {'V', 'E', 'L', '1'};
+    const std::size_t kHeaderSize = 32;
+}
+
+EventLibrary::EventLibrary()
+{
+    DefineCommands();
+}
+
+EventLibrary::~EventLibrary()
+{
+    Close();
+    delete fMessenger;
+}
+
+void EventLibrary::DefineCommands()
+{
+    fMessenger = new G4GenericMessenger(this, "/veto/library/", "Per-event SiPM photon library for pile-up overlay");
+    fMessenger->DeclareMethod("file", &EventLibrary::SetFile, "Library output file")
+        .SetToBeBroadcasted(false);
+    fMessenger->DeclareMethod("record", &EventLibrary::SetRecord, "Record detected photon lists per event")
+        .SetToBeBroadcasted(false);
+    fMessenger->DeclareMethod("close", &EventLibrary::Close, "Finish and close the library file")
+        .SetToBeBroadcasted(false);
+}
+
+void EventLibrary::SetFile(const G4String& fileName)
+{
+    const G4bool recording = IsRecording();
+    Close();
+    fOutName = fileName;
+    if (recording) SetRecord(true);
+}
+
+void EventLibrary::SetRecord(G4bool record)
+{
+    if (!record) { Close(); return; }
+    if (fOut.is_open()) return;
+
+    fOut.open(fOutName, std::ios::binary | std::ios::trunc);
+    if (!fOut) {
+        G4cout << "[Library] cannot open " << fOutName << "; recording off." << G4endl;
+        return;
+    }
+    fOffsets.clear();
+    fNHits = 0;
+    fNChannels = 0;
+    fFlags = 0;
+    char header[kHeaderSize] = {};
+    std::memcpy(header, kMagic, 4);
+    fOut.write(header, kHeaderSize);
+    fEnd = kHeaderSize;
+}
+
+void EventLibrary::WriteEvent(std::vector<Hit>& hits, G4double weight, G4bool rateWeighted)
+{
+    // 시각 순 → overlay 가 창 밖 광자를 바로 건너뜀
+    std::sort(hits.begin(), hits.end(), [](const Hit& a, const Hit& b) { return a.time < b.time; });
+    uint32_t maxChannel = 0;
+    for (const auto& h : hits) maxChannel = std::max(maxChannel, h.channel + 1);
+    const EventHeader eh{uint32_t(hits.size()), float(weight)};
+
+    G4AutoLock lock(&libraryMutex);
+    if (!fOut.is_open()) return;
+    fOffsets.push_back(fEnd);
+    fOut.write(reinterpret_cast<const char*>(&eh), sizeof(eh));
+    if (!hits.empty())
+        fOut.write(reinterpret_cast<const char*>(hits.data()), hits.size()*sizeof(Hit));
+    fEnd += sizeof(eh) + hits.size()*sizeof(Hit);
+    fNHits += hits.size();
+    fNChannels = std::max(fNChannels, maxChannel);
+    if (rateWeighted) fFlags |= kRateWeights;
+}
+
+void EventLibrary::EndOfRun()
+{
+    G4AutoLock lock(&libraryMutex);
+    if (!fOut.is_open()) return;
+    // 색인을 끝에 쓰고 헤더 갱신 → 다음 런은 색인 자리부터 이어서 기록
+    fOut.seekp(fEnd);
+    if (!fOffsets.empty())
+        fOut.write(reinterpret_cast<const char*>(fOffsets.data()), fOffsets.size()*sizeof(uint64_t));
+    const uint64_t nEvents = fOffsets.size();
+    fOut.seekp(4);
+    fOut.write(reinterpret_cast<const char*>(&fFlags), sizeof(fFlags));
+    fOut.write(reinterpret_cast<const char*>(&nEvents), sizeof(nEvents));
+    fOut.write(reinterpret_cast<const char*>(&fEnd), sizeof(fEnd));
+    fOut.write(reinterpret_cast<const char*>(&fNChannels), sizeof(fNChannels));
+    fOut.seekp(fEnd);
+    fOut.flush();
+    G4cout << "[Library] " << nEvents << " events, " << fNHits << " photons, " << fNChannels
+           << " channels -> " << fOutName << " ("
+           << G4double(fEnd + nEvents*sizeof(uint64_t))/(1024.*1024.) << " MB)" << G4endl;
+}
+
+void EventLibrary::Close()
+{
+    if (!fOut.is_open()) return;
+    EndOfRun();
+    fOut.close();
+}
@@ -0,0 +1,231 @@
+#include "FiberTransportModel.hh"
+
+#include "G4FastTrack.hh"
+#include "G4FastStep.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4DynamicParticle.hh"
+#include "G4Material.hh"
+#include "G4MaterialPropertiesTable.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4Tubs.hh"
+#include "G4RunManager.hh"
+#include "G4Run.hh"
+#include "G4SystemOfUnits.hh"
+#include "CLHEP/Units/PhysicalConstants.h"
+#include "Randomize.hh"
+#include "G4Exp.hh"
+#include "G4Log.hh"
+
+#include <algorithm>
+#include <cmath>
+
+G4bool   FiberTransportModel::fEnabled = false;
+G4double FiberTransportModel::fEndReflectivity = 0.98;
+
+namespace {
+    const G4int kNEnergyBins = 256;
+    const G4int kNInvCDF     = 512;
+    const G4int kMaxSegments = 100; // WLS/끝면 반사 반복 상한
+    // 끝면에서 내보내는 광자는 이만큼 안쪽 (surface tolerance 보다 큼) →
+    //  Geant4 가 core → coupling (또는 돌출부) 경계를 그대로 처리
+    const G4double kFaceInset = 1.0e-6*mm;
+}
+
+FiberTransportModel::FiberTransportModel(const G4String& name, G4Region* envelope)
+    : G4VFastSimulationModel(name, envelope),
+      fTablesBuilt(false), fCoreMat(nullptr),
+      fNCore(1.59), fNClad(1.49), fRCore(0.48*mm),
+      fEmin(0), fEmax(0), fDE(1), fWLSTime(0)
+{}
+
+FiberTransportModel::~FiberTransportModel() {}
+
+G4bool FiberTransportModel::IsApplicable(const G4ParticleDefinition& particle)
+{
+    return &particle == G4OpticalPhoton::OpticalPhotonDefinition();
+}
+
+// ----------------------------------------------------------------------
+// PS_Core MPT 로부터 에너지별 감쇠/WLS 테이블 생성 (런마다, ModelTrigger)
+// ----------------------------------------------------------------------
+void FiberTransportModel::BuildTables()
+{
+    fCoreMat = G4Material::GetMaterial("PS_Core", false);
+    auto clad = G4Material::GetMaterial("PMMA_Clad", false);
+    if (!fCoreMat || !fCoreMat->GetMaterialPropertiesTable()) {
+        G4Exception("FiberTransportModel::BuildTables", "Fiber001", FatalException,
+                    "PS_Core material properties are not defined.");
+        return;
+    }
+    auto mpt    = fCoreMat->GetMaterialPropertiesTable();
+    auto rindex = mpt->GetProperty("RINDEX");
+    auto abs    = mpt->GetProperty("ABSLENGTH");
+    auto wlsAbs = mpt->GetProperty("WLSABSLENGTH");
+    auto wlsEm  = mpt->GetProperty("WLSCOMPONENT");
+
+    fEmin = rindex->Energy(0);
+    fEmax = rindex->GetMaxEnergy();
+    fDE   = (fEmax - fEmin) / kNEnergyBins;
+    G4double Emid = 0.5*(fEmin + fEmax);
+    fNCore = rindex->Value(Emid);
+    if (clad && clad->GetMaterialPropertiesTable() &&
+        clad->GetMaterialPropertiesTable()->GetProperty("RINDEX"))
+        fNClad = clad->GetMaterialPropertiesTable()->GetProperty("RINDEX")->Value(Emid);
+    fWLSTime = mpt->ConstPropertyExists("WLSTIMECONSTANT")
+             ? mpt->GetConstProperty("WLSTIMECONSTANT") : 0.;
+
+    fMuTotal.assign(kNEnergyBins, 0.);
+    fWLSFraction.assign(kNEnergyBins, 0.);
+    for (G4int i = 0; i < kNEnergyBins; i++) {
+        G4double E = fEmin + (i + 0.5)*fDE;
+        G4double muAbs = abs    ? 1.0/abs->Value(E)    : 0.;
+        G4double muWLS = wlsAbs ? 1.0/wlsAbs->Value(E) : 0.;
+        fMuTotal[i]     = muAbs + muWLS;
+        fWLSFraction[i] = (fMuTotal[i] > 0) ? muWLS/fMuTotal[i] : 0.;
+    }
+
+    // WLS 재방출 스펙트럼의 역 CDF (균일 u 격자)
+    std::vector<G4double> cdf(kNEnergyBins + 1, 0.);
+    for (G4int i = 0; i < kNEnergyBins; i++) {
+        G4double E = fEmin + (i + 0.5)*fDE;
+        cdf[i+1] = cdf[i] + (wlsEm ? wlsEm->Value(E) : 1.0);
+    }
+    fWLSEmitInvCDF.assign(kNInvCDF + 1, fEmin);
+    for (G4int k = 0, i = 0; k <= kNInvCDF; k++) {
+        G4double target = cdf.back() * k / kNInvCDF;
+        while (i < kNEnergyBins - 1 && cdf[i+1] < target) i++;
+        G4double w = cdf[i+1] - cdf[i];
+        G4double f = (w > 0) ? (target - cdf[i]) / w : 0.;
+        fWLSEmitInvCDF[k] = fEmin + (i + std::min(std::max(f, 0.), 1.))*fDE;
+    }
+
+    fTablesBuilt = true;
+}
+
+G4int FiberTransportModel::EnergyBin(G4double energy) const
+{
+    G4int i = G4int((energy - fEmin) / fDE);
+    return std::min(std::max(i, 0), kNEnergyBins - 1);
+}
+
+// ----------------------------------------------------------------------
+// 이상적 원통에서는 core 벽 입사각이 반사마다 보존 → 한 번의 판정으로 충분
+// ----------------------------------------------------------------------
+G4bool FiberTransportModel::IsTrapped(const G4ThreeVector& pos, const G4ThreeVector& dir) const
+{
+    G4double a = dir.x()*dir.x() + dir.y()*dir.y();
+    if (a < 1e-12) return true; // 축과 평행
+    G4double b = pos.x()*dir.x() + pos.y()*dir.y();
+    G4double c = pos.x()*pos.x() + pos.y()*pos.y() - fRCore*fRCore;
+    G4double disc = std::max(b*b - a*c, 0.);
+    G4double t  = (-b + std::sqrt(disc)) / a;
+    G4double wx = pos.x() + t*dir.x(), wy = pos.y() + t*dir.y();
+    G4double cosI  = std::fabs(wx*dir.x() + wy*dir.y()) / fRCore;
+    G4double sinI2 = 1.0 - cosI*cosI;
+    return sinI2 >= (fNClad/fNCore)*(fNClad/fNCore);
+}
+
+G4bool FiberTransportModel::ModelTrigger(const G4FastTrack& fastTrack)
+{
+    if (!fEnabled) return false;
+
+    // 런마다 첫 호출에서 테이블 재생성 → 런 사이에 바뀐 PS_Core MPT (스캔, 명령) 반영
+    auto run = G4RunManager::GetRunManager()->GetCurrentRun();
+    const G4int runID = run ? run->GetRunID() : fTablesRunID;
+    if (!fTablesBuilt || runID != fTablesRunID) {
+        BuildTables();
+        fTablesRunID = runID;
+    }
+
+    auto track = fastTrack.GetPrimaryTrack();
+    if (track->GetMaterial() != fCoreMat) return false;
+
+    auto tubs = dynamic_cast<const G4Tubs*>(track->GetVolume()->GetLogicalVolume()->GetSolid());
+    if (tubs) fRCore = tubs->GetOuterRadius();
+
+    const G4ThreeVector pos = fastTrack.GetPrimaryTrackLocalPosition();
+    const G4ThreeVector dir = fastTrack.GetPrimaryTrackLocalDirection();
+    // 이 모델이 +Z 끝면 바로 안쪽에 내보낸 광자: 끝면까지는 Geant4 가 추적
+    auto envelopeTubs = dynamic_cast<const G4Tubs*>(fastTrack.GetEnvelopeSolid());
+    if (envelopeTubs && dir.z() > 0 && pos.z() >= envelopeTubs->GetZHalfLength() - 2.*kFaceInset)
+        return false;
+
+    return IsTrapped(pos, dir);
+}
+
+// ----------------------------------------------------------------------
+// 포획 광자를 +Z 끝까지 한 번에 수송
+// ----------------------------------------------------------------------
+void FiberTransportModel::DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep)
+{
+    auto track = fastTrack.GetPrimaryTrack();
+    auto envelopeTubs = dynamic_cast<const G4Tubs*>(fastTrack.GetEnvelopeSolid());
+    const G4double h = envelopeTubs ? envelopeTubs->GetZHalfLength() : 90.*mm;
+    const G4double vCore = CLHEP::c_light / fNCore;
+
+    G4ThreeVector pos = fastTrack.GetPrimaryTrackLocalPosition();
+    G4ThreeVector dir = fastTrack.GetPrimaryTrackLocalDirection();
+    G4double E = track->GetTotalEnergy();
+    G4double t = track->GetGlobalTime();
+
+    fastStep.KillPrimaryTrack();
+    fastStep.SetNumberOfSecondaryTracks(1);
+
+    // 광자를 (로컬) pos/dir 로 Geant4 에 되돌려 준다
+    auto Emit = [&](const G4ThreeVector& p, const G4ThreeVector& d) {
+        G4DynamicParticle photon(G4OpticalPhoton::OpticalPhotonDefinition(), d, E);
+        photon.SetPolarization(d.orthogonal().unit().rotate(CLHEP::twopi*G4UniformRand(), d));
+        fastStep.CreateSecondaryTrack(photon, p, t, true);
+    };
+
+    for (G4int seg = 0; seg < kMaxSegments; seg++) {
+        G4double cosAx = std::fabs(dir.z());
+        G4double L = (dir.z() > 0) ? (h - pos.z())/cosAx : (pos.z() + h)/cosAx;
+
+        G4int bin = EnergyBin(E);
+        G4double s = (fMuTotal[bin] > 0) ? -G4Log(G4UniformRand())/fMuTotal[bin] : L + 1.;
+
+        if (s < L) {
+            // 도중 흡수: 벌크 흡수면 소멸, WLS 면 재방출
+            t += s / vCore;
+            if (G4UniformRand() >= fWLSFraction[bin]) return;
+
+            pos.setZ(pos.z() + s*dir.z());
+            G4double rr  = fRCore*std::sqrt(G4UniformRand());
+            G4double phi = CLHEP::twopi*G4UniformRand();
+            pos.setX(rr*std::cos(phi)); pos.setY(rr*std::sin(phi));
+
+            E = fWLSEmitInvCDF[G4int(G4UniformRand()*kNInvCDF)];
+            t -= fWLSTime*G4Log(G4UniformRand());
+            G4double cost = 1.0 - 2.0*G4UniformRand();
+            G4double sint = std::sqrt(1.0 - cost*cost);
+            phi = CLHEP::twopi*G4UniformRand();
+            dir.set(sint*std::cos(phi), sint*std::sin(phi), cost);
+
+            // 포획되지 않은 재방출 광자는 Geant4 가 추적
+            if (!IsTrapped(pos, dir)) { Emit(pos, dir); return; }
+            continue;
+        }
+
+        t += L / vCore;
+        if (dir.z() > 0) {
+            // +Z 끝 도달: 횡방향 위치/방향은 임의 방위각으로 회전 (긴 파이버 평균)
+            G4double rot = CLHEP::twopi*G4UniformRand();
+            pos.setZ(h - kFaceInset);
+            pos.rotateZ(rot);
+            dir.rotateZ(rot);
+            Emit(pos, dir);
+            return;
+        }
+
+        // -Z 끝: 테플론 Lambertian 반사
+        if (G4UniformRand() >= fEndReflectivity) return;
+        pos.setZ(-h + kFaceInset);
+        G4double cost = std::sqrt(G4UniformRand());
+        G4double sint = std::sqrt(1.0 - cost*cost);
+        G4double phi  = CLHEP::twopi*G4UniformRand();
+        dir.set(sint*std::cos(phi), sint*std::sin(phi), cost);
+        if (!IsTrapped(pos, dir)) { Emit(pos, dir); return; }
+    }
+}
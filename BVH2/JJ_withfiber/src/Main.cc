@@ -1,13 +1,39 @@
 #include "G4RunManager.hh"
+#include "G4RunManagerFactory.hh"
 #include "G4UImanager.hh"
 #include "G4VisExecutive.hh"
 #include "G4UIExecutive.hh"
 #include "DetectorConstruction.hh"
 #include "PhysicsList.hh"
 #include "ActionInitialization.hh"
+#include "ResponseTableBuilder.hh"
+#include "ParameterScan.hh"
+#include "BeamScan.hh"
+#include "AdaptiveRun.hh"
+#include "EfficiencyMode.hh"
+#include "TrajectoryFilter.hh"
+#include "ResultCache.hh"
+#include "PhaseSpace.hh"
+#include "EventLibrary.hh"
 
+#include "TROOT.h"
+#include "TH1.h"
+
+#include <cstdlib>
+
+// 사용법: SiPM_Scintillator [macro] [threads]  (threads > 1 이면 멀티스레드)
 int main(int argc, char** argv) {
-    auto* runManager = new G4RunManager();
+    const G4int nThreads = (argc > 2) ? std::atoi(argv[2]) : 1;
+    G4RunManager* runManager = nullptr;
+    if (nThreads > 1) {
+        // 작업 스레드가 히스토그램을 만들므로 ROOT 스레드 안전 + 디렉토리 자동 등록 끔
+        ROOT::EnableThreadSafety();
+        TH1::AddDirectory(kFALSE);
+        runManager = G4RunManagerFactory::CreateRunManager(G4RunManagerType::Default);
+        runManager->SetNumberOfThreads(nThreads);
+    } else {
+        runManager = G4RunManagerFactory::CreateRunManager(G4RunManagerType::Serial);
+    }
 
     G4cout << "Initializing detector construction..." << G4endl;
     runManager->SetUserInitialization(new DetectorConstruction());
@@ -18,6 +44,25 @@ int main(int argc, char** argv) {
     G4cout << "Initializing actions..." << G4endl;
     runManager->SetUserInitialization(new ActionInitialization());
 
+    // 세그먼트 응답 테이블 (/veto/response/...)
+    auto* responseBuilder = new ResponseTableBuilder();
+    // 설계 파라미터 스캔 (/veto/scan/...)
+    auto* parameterScan = new ParameterScan();
+    // Phase-space 기록/재생 (/veto/phasespace/...)
+    auto* phaseSpace = new PhaseSpace();
+    // pile-up overlay 용 이벤트 라이브러리 (/veto/library/...)
+    auto* eventLibrary = new EventLibrary();
+    // 입사 위치/각도 효율 스캔 (/veto/beamscan/...)
+    auto* beamScan = new BeamScan();
+    // 목표 정밀도까지 실행 (/veto/adaptive/...)
+    auto* adaptiveRun = new AdaptiveRun();
+    // 효율 런 문턱 도달 시 광자 중단 (/veto/efficiency/...)
+    auto* efficiencyMode = new EfficiencyMode();
+    // 동일 설정 결과 캐시 (/veto/cache/...)
+    auto* resultCache = new ResultCache();
+    // 광학 광자 궤적 저장 필터 (/veto/trajectory/...)
+    auto* trajectoryFilter = new TrajectoryFilter();
+
     G4VisManager* visManager = new G4VisExecutive();
     visManager->Initialize();
 
@@ -38,6 +83,15 @@ int main(int argc, char** argv) {
 }
 
 
+    delete trajectoryFilter;
+    delete resultCache;
+    delete efficiencyMode;
+    delete adaptiveRun;
+    delete beamScan;
+    delete eventLibrary;
+    delete phaseSpace;
+    delete parameterScan;
+    delete responseBuilder;
     delete visManager;
     delete runManager;
 
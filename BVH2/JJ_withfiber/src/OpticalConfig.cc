@@ -0,0 +1,126 @@
+#include "OpticalConfig.hh"
+#include "PhotonBatchEngine.hh"
+
+#include "G4OpticalParameters.hh"
+#include "G4RunManager.hh"
+#include "G4StateManager.hh"
+#include "G4UImanager.hh"
+#include "G4Track.hh"
+#include "G4VProcess.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Material.hh"
+
+#include <sstream>
+
+std::vector<G4String> OpticalConfig::fKillCerenkovIn;
+std::vector<G4String> OpticalConfig::fKillWLSIn;
+G4bool OpticalConfig::fPhotonsWaiting = false;
+G4bool OpticalConfig::fPhotonsStaged = false;
+G4int  OpticalConfig::fPhotonBatchLimit = 5000;
+
+namespace {
+    std::vector<G4String> ParseNames(const G4String& list)
+    {
+        std::vector<G4String> v;
+        std::istringstream is(list);
+        G4String name;
+        while (is >> name) v.push_back(name);
+        return v;
+    }
+
+    // 초기화 뒤에는 프로세스 테이블이 다시 읽도록
+    void PhysicsModified()
+    {
+        if (G4StateManager::GetStateManager()->GetCurrentState() != G4State_PreInit)
+            G4RunManager::GetRunManager()->PhysicsHasBeenModified();
+    }
+}
+
+// ----------------------------------------------------------------------
+// 전역 스위치
+// ----------------------------------------------------------------------
+void OpticalConfig::SetProcess(const G4String& name, G4bool on)
+{
+    // 초기화 전: G4OpticalPhysics 가 등록 여부 결정, 이후: 프로세스 (비)활성화 (워커에 전달)
+    G4OpticalParameters::Instance()->SetProcessActivation(name, on);
+    if (G4StateManager::GetStateManager()->GetCurrentState() != G4State_PreInit)
+        G4UImanager::GetUIpointer()->ApplyCommand((on ? "/process/activate " : "/process/inactivate ") + name);
+}
+
+void OpticalConfig::SetCerenkov(G4bool on) { SetProcess("Cerenkov", on); }
+void OpticalConfig::SetWLS(G4bool on)      { SetProcess("OpWLS", on); }
+
+void OpticalConfig::SetCerenkovMaxPhotons(G4int n)
+{
+    G4OpticalParameters::Instance()->SetCerenkovMaxPhotonsPerStep(n);
+    PhysicsModified();
+}
+
+void OpticalConfig::SetCerenkovMaxBetaChange(G4double percent)
+{
+    G4OpticalParameters::Instance()->SetCerenkovMaxBetaChange(percent);
+    PhysicsModified();
+}
+
+void OpticalConfig::SetTrackSecondariesFirst(G4bool on)
+{
+    auto params = G4OpticalParameters::Instance();
+    params->SetCerenkovTrackSecondariesFirst(on);
+    params->SetScintTrackSecondariesFirst(on);
+    PhysicsModified();
+}
+
+// ----------------------------------------------------------------------
+// 재질/볼륨별 제거 (빈 목록 = 해제)
+// ----------------------------------------------------------------------
+void OpticalConfig::SetKillCerenkovIn(const G4String& names) { fKillCerenkovIn = ParseNames(names); }
+void OpticalConfig::SetKillWLSIn(const G4String& names)      { fKillWLSIn = ParseNames(names); }
+
+G4bool OpticalConfig::Matches(const std::vector<G4String>& names, const G4Track* track)
+{
+    auto pv = track->GetVolume();   // 생성 지점의 볼륨
+    if (!pv) return false;
+    auto lv = pv->GetLogicalVolume();
+    const G4String& material = lv->GetMaterial()->GetName();
+    for (const auto& name : names)
+        if (material == name || lv->GetName().compare(0, name.size(), name) == 0) return true;
+    return false;
+}
+
+G4bool OpticalConfig::IsKilled(const G4Track* track)
+{
+    // 배치 엔진 검증: 엔진은 신틸레이션 genstep 만 전파 → Geant4 쪽 Cerenkov 광자도 버려
+    //  hNpe 와 hNpeBatched 가 같은 광원 (신틸레이션 + 그 WLS) 을 비교하게 함
+    const G4bool validate = PhotonBatchEngine::GetMode() == PhotonBatchEngine::kValidate;
+    if (!validate && fKillCerenkovIn.empty() && fKillWLSIn.empty()) return false;
+    auto creator = track->GetCreatorProcess();
+    if (!creator) return false;
+
+    const G4String& process = creator->GetProcessName();
+    if (validate && process == "Cerenkov") return true;
+    if (process == "Cerenkov") return Matches(fKillCerenkovIn, track);
+    if (process == "OpWLS")    return Matches(fKillWLSIn, track);
+    return false;
+}
+
+void OpticalConfig::SetPhotonStack(const G4String& stack)
+{
+    fPhotonsStaged  = (stack == "staged");
+    fPhotonsWaiting = fPhotonsStaged || stack == "waiting";
+}
+
+void OpticalConfig::Report()
+{
+    auto params = G4OpticalParameters::Instance();
+    G4cout << "[Optical] Cerenkov " << (params->GetProcessActivation("Cerenkov") ? "on" : "off")
+           << " (max " << params->GetCerenkovMaxPhotonsPerStep() << "/step, dβ "
+           << params->GetCerenkovMaxBetaChange() << "%)"
+           << " | WLS " << (params->GetProcessActivation("OpWLS") ? "on" : "off")
+           << " | secondaries first " << (params->GetScintTrackSecondariesFirst() ? "yes" : "no")
+           << " | photon stack " << (fPhotonsStaged ? "staged" : fPhotonsWaiting ? "waiting" : "urgent");
+    if (fPhotonsStaged) G4cout << " (batch " << fPhotonBatchLimit << ")";
+    for (const auto& name : fKillCerenkovIn) G4cout << " | kill Cerenkov in " << name;
+    for (const auto& name : fKillWLSIn)      G4cout << " | kill WLS in " << name;
+    G4cout << G4endl;
+}
@@ -0,0 +1,85 @@
+#include "OpticalSurfaceRegistry.hh"
+
+#include "G4LogicalSkinSurface.hh"
+#include "G4LogicalBorderSurface.hh"
+#include "G4MaterialPropertiesTable.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+
+OpticalSurfaceRegistry* OpticalSurfaceRegistry::Instance()
+{
+    static OpticalSurfaceRegistry instance;
+    return &instance;
+}
+
+OpticalSurfaceRegistry::OpticalSurfaceRegistry() {}
+
+OpticalSurfaceRegistry::~OpticalSurfaceRegistry() {}
+
+// 표면은 G4SurfaceProperty 테이블이 소유, 상수 MPT 는 다음 형상에서 새로 생성
+void OpticalSurfaceRegistry::Clear()
+{
+    fSurfaces.clear();
+    fTables.clear();
+}
+
+G4MaterialPropertiesTable* OpticalSurfaceRegistry::GetConstantPropertyTable(
+    const G4String& property, G4double value, const std::vector<G4double>& energies)
+{
+    TableKey key(property, value, energies.size(), energies.front(), energies.back());
+    auto it = fTables.find(key);
+    if (it != fTables.end()) return it->second;
+
+    auto mpt = new G4MaterialPropertiesTable();
+    std::vector<G4double> values(energies.size(), value);
+    mpt->AddProperty(property, energies, values);
+    fTables[key] = mpt;
+    return mpt;
+}
+
+G4OpticalSurface* OpticalSurfaceRegistry::GetSurface(const G4String& name, G4SurfaceType type,
+                                                     G4OpticalSurfaceModel model,
+                                                     G4OpticalSurfaceFinish finish,
+                                                     G4MaterialPropertiesTable* mpt)
+{
+    SurfaceKey key(type, model, finish, mpt);
+    auto it = fSurfaces.find(key);
+    if (it != fSurfaces.end()) return it->second;
+
+    auto surface = new G4OpticalSurface(name);
+    surface->SetType(type);
+    surface->SetModel(model);
+    surface->SetFinish(finish);
+    if (mpt) surface->SetMaterialPropertiesTable(mpt);
+    fSurfaces[key] = surface;
+    return surface;
+}
+
+G4bool OpticalSurfaceRegistry::AddSkinSurface(const G4String& name, G4LogicalVolume* lv,
+                                              G4OpticalSurface* surface)
+{
+    if (G4LogicalSkinSurface::GetSurface(lv)) return false;
+    new G4LogicalSkinSurface(name, lv, surface);
+    return true;
+}
+
+G4bool OpticalSurfaceRegistry::AddBorderSurface(const G4String& name, G4VPhysicalVolume* pv1,
+                                                G4VPhysicalVolume* pv2, G4OpticalSurface* surface)
+{
+    // 물성 없는 polished 유전체 경계 = 표면 미정의와 동일 (Fresnel)
+    if (surface->GetType() == dielectric_dielectric && surface->GetFinish() == polished &&
+        !surface->GetMaterialPropertiesTable())
+        return false;
+    if (G4LogicalBorderSurface::GetSurface(pv1, pv2)) return false;
+    new G4LogicalBorderSurface(name, pv1, pv2, surface);
+    return true;
+}
+
+void OpticalSurfaceRegistry::Report() const
+{
+    G4cout << "[Surface] shared optical surfaces: " << fSurfaces.size()
+           << ", shared property tables: " << fTables.size()
+           << ", skin surfaces: " << G4LogicalSkinSurface::GetNumberOfSkinSurfaces()
+           << ", border surfaces: " << G4LogicalBorderSurface::GetNumberOfBorderSurfaces()
+           << G4endl;
+}
@@ -0,0 +1,159 @@
+#include "ParameterScan.hh"
+#include "DetectorConstruction.hh"
+#include "YieldScan.hh"
+
+#include "G4GenericMessenger.hh"
+#include "G4RunManager.hh"
+#include "G4UImanager.hh"
+#include "G4Timer.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <fstream>
+#include <sstream>
+
+G4String ParameterScan::fPointLabel;
+
+namespace {
+    // 이름 → (단위, 형상 파라미터 여부)
+    const std::map<G4String, std::pair<G4double, G4bool>> kParameters = {
+        {"groove",       {mm, true}},
+        {"fiberRadius",  {mm, true}},
+        {"fiberZ",       {mm, true}},
+        {"coupling",     {mm, true}},
+        {"yield",        {1./MeV, false}},
+        {"reflectivity", {1., false}},
+    };
+}
+
+ParameterScan::ParameterScan()
+{
+    DefineCommands();
+}
+
+ParameterScan::~ParameterScan()
+{
+    delete fMessenger;
+}
+
+void ParameterScan::DefineCommands()
+{
+    fMessenger = new G4GenericMessenger(this, "/veto/scan/", "In-process design parameter scan");
+    fMessenger->DeclareProperty("events", fEventsPerPoint, "Events per scan point")
+        .SetToBeBroadcasted(false);
+    fMessenger->DeclareMethod("run", &ParameterScan::Run,
+                              "Run every point of a parameter file (after /run/initialize)")
+        .SetToBeBroadcasted(false);
+}
+
+// ----------------------------------------------------------------------
+// 바뀐 값만 적용. 형상 값은 점 전체를 먼저 검사 → 잘못된 점은 아무것도 바꾸지 않음
+//  (검출기와 fCurrent 가 다음 점의 "변화 없음" 판단과 항상 일치)
+// ----------------------------------------------------------------------
+G4bool ParameterScan::Apply(DetectorConstruction* detector,
+                            const std::map<G4String, G4double>& point, G4bool& ok)
+{
+    auto Value = [&](const G4String& name, G4double current) {
+        auto it = point.find(name);
+        return it != point.end() ? it->second : current;
+    };
+    const G4double groove   = Value("groove",      detector->GetGrooveSize());
+    const G4double radius   = Value("fiberRadius", detector->GetFiberRadius());
+    const G4double fiberZ   = Value("fiberZ",      detector->GetFiberZCenter());
+    const G4double coupling = Value("coupling",    detector->GetCouplingThickness());
+    const G4bool geometryChanged =
+        groove != detector->GetGrooveSize() || radius != detector->GetFiberRadius() ||
+        fiberZ != detector->GetFiberZCenter() || coupling != detector->GetCouplingThickness();
+
+    ok = !geometryChanged || detector->SetFiberDesign(groove, radius, fiberZ, coupling);
+    if (!ok) return false;
+
+    for (const auto& [name, value] : point) {
+        if (kParameters.at(name).second) continue;
+        auto it = fCurrent.find(name);
+        if (it != fCurrent.end() && it->second == value) continue;
+        if      (name == "yield")        YieldScan::SetBaseYield(value);
+        else if (name == "reflectivity") detector->SetWrapReflectivity(value);
+        fCurrent[name] = value;
+    }
+    return geometryChanged;
+}
+
+void ParameterScan::Run(const G4String& fileName)
+{
+    auto runManager = G4RunManager::GetRunManager();
+    auto detector = const_cast<DetectorConstruction*>(
+        dynamic_cast<const DetectorConstruction*>(runManager->GetUserDetectorConstruction()));
+    std::ifstream in(fileName);
+    if (!in || !detector) {
+        G4cout << "[Scan] cannot read " << fileName << G4endl;
+        return;
+    }
+
+    // 헤더 (파라미터 이름) + 점 목록
+    std::vector<G4String> names;
+    std::vector<std::map<G4String, G4double>> points;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream is(line);
+        if (names.empty()) {
+            G4String name;
+            while (is >> name) {
+                if (!kParameters.count(name)) {
+                    G4cout << "[Scan] unknown parameter " << name << G4endl;
+                    return;
+                }
+                names.push_back(name);
+            }
+            continue;
+        }
+        std::map<G4String, G4double> point;
+        G4double v;
+        for (const auto& name : names) {
+            if (!(is >> v)) break;
+            point[name] = v * kParameters.at(name).first;
+        }
+        if (point.size() == names.size()) points.push_back(point);
+    }
+    G4cout << "[Scan] " << points.size() << " points x " << fEventsPerPoint << " events from "
+           << fileName << G4endl;
+
+    auto ui = G4UImanager::GetUIpointer();
+    ui->ApplyCommand("/veto/output/runDirectories true");
+
+    G4Timer scanTimer;
+    scanTimer.Start();
+    G4int rebuilds = 0;
+    for (std::size_t i = 0; i < points.size(); i++) {
+        G4bool ok = true;
+        G4bool rebuild = Apply(detector, points[i], ok);
+        if (!ok) {
+            G4cout << "[Scan] point " << i << ": parameter out of range, skipped" << G4endl;
+            continue;
+        }
+        // 형상만 재구성: 다음 BeamOn 에서 Construct (재질, 영역, 물리 테이블 유지)
+        if (rebuild) {
+            runManager->ReinitializeGeometry(true);
+            rebuilds++;
+        }
+
+        std::ostringstream label;
+        label << "point " << i;
+        for (const auto& name : names)
+            label << " " << name << "=" << points[i].at(name) / kParameters.at(name).first;
+        fPointLabel = label.str();
+        G4cout << "[Scan] " << fPointLabel << (rebuild ? " (geometry rebuilt)" : " (MPT only)") << G4endl;
+
+        G4Timer pointTimer;
+        pointTimer.Start();
+        runManager->BeamOn(fEventsPerPoint);
+        pointTimer.Stop();
+        G4cout << "[Scan] point " << i << " done in " << pointTimer.GetRealElapsed() << " s" << G4endl;
+    }
+    scanTimer.Stop();
+    fPointLabel = "";
+    ui->ApplyCommand("/veto/output/runDirectories false");
+
+    G4cout << "[Scan] finished: " << points.size() << " points, " << rebuilds
+           << " geometry rebuilds, " << scanTimer.GetRealElapsed() << " s" << G4endl;
+}
@@ -0,0 +1,228 @@
+#include "PhaseSpace.hh"
+
+#include "G4GenericMessenger.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4AutoLock.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+PhaseSpace::Mode   PhaseSpace::fMode = PhaseSpace::kOff;
+G4double           PhaseSpace::fPlaneX = -50.*mm;
+G4bool             PhaseSpace::fKillRecorded = true;
+std::ofstream      PhaseSpace::fOut;
+G4String           PhaseSpace::fOutName = "phasespace.bin";
+uint64_t           PhaseSpace::fNEvents = 0;
+uint64_t           PhaseSpace::fNRecords = 0;
+uint32_t           PhaseSpace::fFlags = 0;
+
+void*                    PhaseSpace::fMapped = nullptr;
+std::size_t              PhaseSpace::fMappedSize = 0;
+const PhaseSpace::Record* PhaseSpace::fRecords = nullptr;
+std::vector<std::size_t> PhaseSpace::fGroups;
+G4double                 PhaseSpace::fReplayScale = 1.;
+uint32_t                 PhaseSpace::fReplayFlags = 0;
+
+namespace {
+    G4Mutex phaseSpaceMutex = G4MUTEX_INITIALIZER;
+    const char        kMagic[4]   = {'V', 'P', 'S', '1'};
+    const std::size_t kHeaderSize = 16;   // magic, flags, 원본 이벤트 수 (uint64)
+}
+
+PhaseSpace::PhaseSpace()
+{
+    DefineCommands();
+}
+
+PhaseSpace::~PhaseSpace()
+{
+    Close();
+    Unmap();
+    delete fMessenger;
+}
+
+void PhaseSpace::DefineCommands()
+{
+    fMessenger = new G4GenericMessenger(this, "/veto/phasespace/", "Phase-space record and replay");
+    fMessenger->DeclareMethod("record", &PhaseSpace::SetMode,
+                              "Record particles crossing the plane or entering a segment envelope")
+        .SetCandidates("off plane envelope").SetToBeBroadcasted(false);
+    fMessenger->DeclarePropertyWithUnit("planeX", "mm", fPlaneX, "Recording plane position along X")
+        .SetToBeBroadcasted(false);
+    fMessenger->DeclareProperty("killRecorded", fKillRecorded,
+                                "Stop tracking particles once they are recorded")
+        .SetToBeBroadcasted(false);
+    fMessenger->DeclareMethod("file", &PhaseSpace::SetFile, "Phase-space output file")
+        .SetToBeBroadcasted(false);
+    fMessenger->DeclareMethod("close", &PhaseSpace::Close, "Finish and close the output file")
+        .SetToBeBroadcasted(false);
+    fMessenger->DeclareMethod("replay", &PhaseSpace::Replay,
+                              "Map a phase-space file for /veto/gun/mode replay")
+        .SetToBeBroadcasted(false);
+}
+
+// ----------------------------------------------------------------------
+// 기록
+// ----------------------------------------------------------------------
+void PhaseSpace::SetFile(const G4String& fileName)
+{
+    Close();
+    fOutName = fileName;
+    if (fMode != kOff) SetMode(fMode == kPlane ? "plane" : "envelope");
+}
+
+void PhaseSpace::SetMode(const G4String& mode)
+{
+    fMode = (mode == "plane") ? kPlane : (mode == "envelope") ? kEnvelope : kOff;
+    if (fMode == kOff) { Close(); return; }
+    if (fOut.is_open()) return;
+
+    fOut.open(fOutName, std::ios::binary | std::ios::trunc);
+    if (!fOut) {
+        G4cout << "[PhaseSpace] cannot open " << fOutName << "; recording off." << G4endl;
+        fMode = kOff;
+        return;
+    }
+    fNEvents = fNRecords = 0;
+    fFlags = 0;
+    char header[kHeaderSize] = {};
+    std::memcpy(header, kMagic, 4);
+    fOut.write(header, kHeaderSize);
+}
+
+G4bool PhaseSpace::Check(const G4Step* step, Record& rec)
+{
+    const G4Track* track = step->GetTrack();
+    if (track->GetDefinition() == G4OpticalPhoton::Definition()) return false;
+
+    auto pre  = step->GetPreStepPoint();
+    auto post = step->GetPostStepPoint();
+    G4ThreeVector pos = post->GetPosition();
+    G4double time = post->GetGlobalTime();
+
+    if (fMode == kPlane) {
+        G4double x0 = pre->GetPosition().x(), x1 = pos.x();
+        if (!((x0 < fPlaneX && x1 >= fPlaneX) || (x0 > fPlaneX && x1 <= fPlaneX))) return false;
+        // 평면 위 점으로 선형 보간
+        G4double f = (fPlaneX - x0) / (x1 - x0);
+        pos  = pre->GetPosition() + f*(pos - pre->GetPosition());
+        time = pre->GetGlobalTime() + f*(time - pre->GetGlobalTime());
+    } else {
+        // envelope 경계를 넘어 Segment 로 들어가는 스텝
+        if (post->GetStepStatus() != fGeomBoundary) return false;
+        auto nextPV = post->GetPhysicalVolume();
+        auto prePV  = pre->GetPhysicalVolume();
+        if (!nextPV || nextPV->GetName() != "Segment" || (prePV && prePV->GetName() == "Segment"))
+            return false;
+    }
+
+    const G4ThreeVector dir = post->GetMomentumDirection();
+    rec.event  = 0;
+    rec.pdg    = track->GetDefinition()->GetPDGEncoding();
+    rec.x  = pos.x()/mm;  rec.y  = pos.y()/mm;  rec.z  = pos.z()/mm;
+    rec.dx = dir.x();     rec.dy = dir.y();     rec.dz = dir.z();
+    rec.ekin   = post->GetKineticEnergy()/MeV;
+    rec.time   = time/ns;
+    rec.weight = track->GetWeight();
+    return true;
+}
+
+void PhaseSpace::WriteEvent(G4int eventID, std::vector<Record>& records, G4bool rateWeighted)
+{
+    for (auto& r : records) r.event = eventID;
+    G4AutoLock lock(&phaseSpaceMutex);
+    if (!fOut.is_open()) return;
+    fNEvents++;
+    fNRecords += records.size();
+    if (rateWeighted) fFlags |= kRateWeights;
+    if (!records.empty())
+        fOut.write(reinterpret_cast<const char*>(records.data()), records.size()*sizeof(Record));
+}
+
+void PhaseSpace::EndOfRun()
+{
+    G4AutoLock lock(&phaseSpaceMutex);
+    if (!fOut.is_open()) return;
+    // 헤더 갱신 후 끝으로 복귀 (다음 런은 이어서 기록)
+    auto end = fOut.tellp();
+    fOut.seekp(4);
+    fOut.write(reinterpret_cast<const char*>(&fFlags), sizeof(fFlags));
+    fOut.write(reinterpret_cast<const char*>(&fNEvents), sizeof(fNEvents));
+    fOut.seekp(end);
+    fOut.flush();
+    G4cout << "[PhaseSpace] " << fNRecords << " records from " << fNEvents << " events -> "
+           << fOutName << " (" << G4double(end)/(1024.*1024.) << " MB)" << G4endl;
+}
+
+void PhaseSpace::Close()
+{
+    if (!fOut.is_open()) return;
+    EndOfRun();
+    fOut.close();
+}
+
+// ----------------------------------------------------------------------
+// 재생 (mmap)
+// ----------------------------------------------------------------------
+void PhaseSpace::Unmap()
+{
+    if (fMapped) munmap(fMapped, fMappedSize);
+    fMapped = nullptr;
+    fMappedSize = 0;
+    fRecords = nullptr;
+    fGroups.clear();
+}
+
+void PhaseSpace::Replay(const G4String& fileName)
+{
+    Unmap();
+    int fd = open(fileName.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || std::size_t(st.st_size) < kHeaderSize) {
+        if (fd >= 0) close(fd);
+        G4cout << "[PhaseSpace] cannot read " << fileName << G4endl;
+        return;
+    }
+    void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED || std::memcmp(p, kMagic, 4) != 0) {
+        if (p != MAP_FAILED) munmap(p, st.st_size);
+        G4cout << "[PhaseSpace] " << fileName << " is not a phase-space file." << G4endl;
+        return;
+    }
+    fMapped = p;
+    fMappedSize = st.st_size;
+    madvise(fMapped, fMappedSize, MADV_SEQUENTIAL);
+
+    const char* base = static_cast<const char*>(fMapped);
+    uint64_t nSource = 0;
+    std::memcpy(&fReplayFlags, base + 4, sizeof(fReplayFlags));
+    std::memcpy(&nSource, base + 8, sizeof(nSource));
+    fRecords = reinterpret_cast<const Record*>(base + kHeaderSize);
+    const std::size_t n = (fMappedSize - kHeaderSize) / sizeof(Record);
+
+    // 같은 원본 이벤트의 연속 레코드 → 묶음
+    for (std::size_t i = 0; i < n; i++)
+        if (i == 0 || fRecords[i].event != fRecords[i-1].event) fGroups.push_back(i);
+    fGroups.push_back(n);
+
+    const std::size_t nGroups = GetNumberOfReplayEvents();
+    fReplayScale = (nSource > 0 && nGroups > 0) ? G4double(nGroups) / nSource : 1.;
+    G4cout << "[PhaseSpace] mapped " << fileName << ": " << n << " records, " << nGroups
+           << " events (source " << nSource << " events)" << G4endl;
+    if (nGroups == 0) Unmap();
+}
+
+void PhaseSpace::GetReplayEvent(G4int i, const Record*& begin, const Record*& end)
+{
+    const std::size_t g = std::size_t(i) % GetNumberOfReplayEvents();
+    begin = fRecords + fGroups[g];
+    end   = fRecords + fGroups[g + 1];
+}
@@ -0,0 +1,609 @@
+#include "PhotonBatchEngine.hh"
+#include "DetectorConstruction.hh"
+
+#include "G4Material.hh"
+#include "G4MaterialPropertiesTable.hh"
+#include "G4OpticalSurface.hh"
+#include "G4SurfaceProperty.hh"
+#include "G4OpticalParameters.hh"
+#include "G4RunManager.hh"
+#include "G4Run.hh"
+#include "G4SystemOfUnits.hh"
+#include "CLHEP/Units/PhysicalConstants.h"
+#include "Randomize.hh"
+#include "G4Exp.hh"
+#include "G4Log.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+PhotonBatchEngine::Mode PhotonBatchEngine::fMode = PhotonBatchEngine::kGeant4;
+G4int PhotonBatchEngine::fBatchSize = 8192;
+
+namespace {
+    const G4double kInf = std::numeric_limits<G4double>::max();
+    const G4double kEps = 1.0e-7 * mm;
+    const G4int    kMaxInteractions = 5000; // 배치당 최대 경계 상호작용 횟수
+
+    // 면(face) 코드
+    enum Face {
+        kScintMinusX = 0, kScintPlusX, kScintMinusY, kScintPlusY,
+        kScintMinusZ, kScintPlusZ, kGrooveWallX, kGrooveWallY,
+        kGlueToScintX, kGlueToScintY, kGluePlusX, kGlueMinusZ, kGluePlusZ,
+        kFiber, kNone
+    };
+
+    // 재질 MPT 에서 상수(파장 무관) 물성 읽기
+    G4double PropertyAt(const G4String& matName, const G4String& key,
+                        G4double energy, G4double fallback)
+    {
+        auto mat = G4Material::GetMaterial(matName, false);
+        if (!mat || !mat->GetMaterialPropertiesTable()) return fallback;
+        auto prop = mat->GetMaterialPropertiesTable()->GetProperty(key);
+        return prop ? prop->Value(energy) : fallback;
+    }
+
+    G4double ConstPropertyOf(const G4String& matName, const G4String& key,
+                             G4double fallback)
+    {
+        auto mat = G4Material::GetMaterial(matName, false);
+        if (!mat || !mat->GetMaterialPropertiesTable()) return fallback;
+        auto mpt = mat->GetMaterialPropertiesTable();
+        return mpt->ConstPropertyExists(key) ? mpt->GetConstProperty(key) : fallback;
+    }
+
+    // 분포(ys)를 사다리꼴 적분한 정규화 CDF
+    std::vector<G4double> BuildCDF(const std::vector<G4double>& xs,
+                                   const std::vector<G4double>& ys)
+    {
+        std::vector<G4double> cdf(xs.size(), 0.0);
+        for (std::size_t i = 1; i < xs.size(); i++)
+            cdf[i] = cdf[i-1] + 0.5 * (ys[i] + ys[i-1]) * (xs[i] - xs[i-1]);
+        if (!cdf.empty() && cdf.back() > 0)
+            for (auto& c : cdf) c /= cdf.back();
+        return cdf;
+    }
+}
+
+// ======================================================================
+void PhotonBatchEngine::Batch::Resize(std::size_t n)
+{
+    x.resize(n); y.resize(n); z.resize(n);
+    dx.resize(n); dy.resize(n); dz.resize(n);
+    t.resize(n); e.resize(n); dist.resize(n);
+    region.resize(n); face.resize(n); segment.resize(n);
+}
+
+PhotonBatchEngine::PhotonBatchEngine()
+    : fInitialized(false), fRunID(-1),
+      fHalfX(1.0*mm), fHalfY(5.0*mm), fHalfZ(70.0*mm),
+      fGrooveXmin(-0.2*mm), fGrooveHalfY(0.6*mm),
+      fFiberX(0.5*mm), fRClad(0.5*mm), fRCore(0.48*mm),
+      fFiberZmin(-70.0*mm), fFiberZmax(110.0*mm), fCoupT(0.1*mm),
+      fNScint(1.58), fNGlue(1.465), fNClad(1.49), fNCore(1.59),
+      fNAir(1.0003), fNSi(1.55),
+      fAbsScint(2.5*m), fAbsGlue(10.*m), fAbsClad(20.*m), fAbsCore(12.*m),
+      fReflectivity(0.98),
+      fRiseTime(0.9*ns), fDecayTime(2.4*ns), fWLSTime(7.0*ns)
+{}
+
+PhotonBatchEngine::~PhotonBatchEngine() {}
+
+void PhotonBatchEngine::SetMode(Mode mode)
+{
+    fMode = mode;
+    // batched 모드에서는 G4Scintillation 이 광자 수만 계산하고 스택에는 올리지 않음
+    G4OpticalParameters::Instance()->SetScintStackPhotons(mode != kBatched);
+}
+
+// ----------------------------------------------------------------------
+// DetectorConstruction 치수와 재질/표면 MPT 에서 상수 읽기
+//  런마다 다시 읽음 → /veto/geometry, 파라미터 스캔, MPT 변경을 따라감
+// ----------------------------------------------------------------------
+void PhotonBatchEngine::Initialize()
+{
+    auto detector = dynamic_cast<const DetectorConstruction*>(
+        G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+    if (detector) {
+        const G4ThreeVector scint = detector->GetScintSize();
+        fHalfX       = scint.x()/2;
+        fHalfY       = scint.y()/2;
+        fHalfZ       = scint.z()/2;
+        fGrooveXmin  = fHalfX - detector->GetGrooveSize();
+        fGrooveHalfY = detector->GetGrooveSize()/2;
+        fRClad       = detector->GetFiberRadius();
+        fRCore       = detector->GetFiberCoreRadius();
+        fFiberX      = fHalfX - fRClad;
+        fFiberZmin   = detector->GetFiberZCenter() - detector->GetFiberLength()/2;
+        fFiberZmax   = detector->GetFiberZCenter() + detector->GetFiberLength()/2;
+        fCoupT       = detector->GetCouplingThickness();
+    }
+
+    auto scint = G4Material::GetMaterial("EJ212", false);
+    auto core  = G4Material::GetMaterial("PS_Core", false);
+    if (!scint || !scint->GetMaterialPropertiesTable() ||
+        !core  || !core->GetMaterialPropertiesTable()) {
+        G4Exception("PhotonBatchEngine::Initialize", "Engine001", FatalException,
+                    "EJ212 / PS_Core material properties are not defined.");
+        return;
+    }
+
+    // 에너지 격자: EJ212 RINDEX 격자 사용
+    auto rindex = scint->GetMaterialPropertiesTable()->GetProperty("RINDEX");
+    fEnergies.clear();
+    for (std::size_t i = 0; i < rindex->GetVectorLength(); i++)
+        fEnergies.push_back(rindex->Energy(i));
+
+    std::vector<G4double> emit, wlsEmit;
+    auto scintComp = scint->GetMaterialPropertiesTable()->GetProperty("SCINTILLATIONCOMPONENT1");
+    auto wlsComp   = core->GetMaterialPropertiesTable()->GetProperty("WLSCOMPONENT");
+    auto wlsAbs    = core->GetMaterialPropertiesTable()->GetProperty("WLSABSLENGTH");
+    fWLSAbs.clear();
+    for (auto E : fEnergies) {
+        emit.push_back(scintComp ? scintComp->Value(E) : 1.0);
+        wlsEmit.push_back(wlsComp ? wlsComp->Value(E) : 1.0);
+        fWLSAbs.push_back(wlsAbs ? wlsAbs->Value(E) : kInf);
+    }
+    fScintCDF   = BuildCDF(fEnergies, emit);
+    fWLSEmitCDF = BuildCDF(fEnergies, wlsEmit);
+
+    // 굴절률/흡수 길이는 현재 파장 무관 상수 → 중앙 에너지 값 사용
+    G4double E0 = fEnergies[fEnergies.size()/2];
+    fNScint   = PropertyAt("EJ212",       "RINDEX",    E0, fNScint);
+    fNGlue    = PropertyAt("OpticalGlue", "RINDEX",    E0, fNGlue);
+    fNClad    = PropertyAt("PMMA_Clad",   "RINDEX",    E0, fNClad);
+    fNCore    = PropertyAt("PS_Core",     "RINDEX",    E0, fNCore);
+    fNAir     = PropertyAt("G4_AIR",      "RINDEX",    E0, fNAir);
+    fNSi      = PropertyAt("G4_Si",       "RINDEX",    E0, fNSi);
+    fAbsScint = PropertyAt("EJ212",       "ABSLENGTH", E0, fAbsScint);
+    fAbsGlue  = PropertyAt("OpticalGlue", "ABSLENGTH", E0, fAbsGlue);
+    fAbsClad  = PropertyAt("PMMA_Clad",   "ABSLENGTH", E0, fAbsClad);
+    fAbsCore  = PropertyAt("PS_Core",     "ABSLENGTH", E0, fAbsCore);
+
+    fRiseTime  = ConstPropertyOf("EJ212",   "SCINTILLATIONRISETIME1",     fRiseTime);
+    fDecayTime = ConstPropertyOf("EJ212",   "SCINTILLATIONTIMECONSTANT1", fDecayTime);
+    fWLSTime   = ConstPropertyOf("PS_Core", "WLSTIMECONSTANT",            fWLSTime);
+
+    // 테플론 반사율: groundfrontpainted 표면의 REFLECTIVITY
+    auto surfTable = G4SurfaceProperty::GetSurfacePropertyTable();
+    for (auto sp : *surfTable) {
+        auto os = dynamic_cast<G4OpticalSurface*>(sp);
+        if (!os || os->GetFinish() != groundfrontpainted) continue;
+        auto mpt = os->GetMaterialPropertiesTable();
+        auto refl = mpt ? mpt->GetProperty("REFLECTIVITY") : nullptr;
+        if (refl) { fReflectivity = refl->Value(E0); break; }
+    }
+
+    fBatch.Resize(fBatchSize);
+    fInitialized = true;
+}
+
+// ----------------------------------------------------------------------
+// 테이블 보간 / 샘플링
+// ----------------------------------------------------------------------
+G4double PhotonBatchEngine::Interpolate(const std::vector<G4double>& xs,
+                                        const std::vector<G4double>& ys,
+                                        G4double x) const
+{
+    if (x <= xs.front()) return ys.front();
+    if (x >= xs.back())  return ys.back();
+    auto it = std::upper_bound(xs.begin(), xs.end(), x);
+    std::size_t i = (it - xs.begin()) - 1;
+    G4double f = (x - xs[i]) / (xs[i+1] - xs[i]);
+    return (1-f)*ys[i] + f*ys[i+1];
+}
+
+G4double PhotonBatchEngine::SampleTable(const std::vector<G4double>& cdf,
+                                        const std::vector<G4double>& xs) const
+{
+    return Interpolate(cdf, xs, G4UniformRand());
+}
+
+// ----------------------------------------------------------------------
+// 비편광 Fresnel 반사율
+// ----------------------------------------------------------------------
+G4double PhotonBatchEngine::Fresnel(G4double n1, G4double n2, G4double cosI) const
+{
+    G4double sinT2 = (n1/n2)*(n1/n2) * (1.0 - cosI*cosI);
+    if (sinT2 >= 1.0) return 1.0;
+    G4double cosT = std::sqrt(1.0 - sinT2);
+    G4double rs = (n1*cosI - n2*cosT) / (n1*cosI + n2*cosT);
+    G4double rp = (n1*cosT - n2*cosI) / (n1*cosT + n2*cosI);
+    return 0.5 * (rs*rs + rp*rp);
+}
+
+// (nx,ny,nz): 진행 방향 쪽(바깥) 법선. 굴절되면 true
+G4bool PhotonBatchEngine::RefractOrReflect(std::size_t i, G4double n1, G4double n2,
+                                           G4double nx, G4double ny, G4double nz)
+{
+    auto& b = fBatch;
+    G4double cosI = b.dx[i]*nx + b.dy[i]*ny + b.dz[i]*nz;
+    if (cosI < 0) { cosI = -cosI; nx = -nx; ny = -ny; nz = -nz; }
+
+    G4double eta   = n1 / n2;
+    G4double sinT2 = eta*eta * (1.0 - cosI*cosI);
+    if (sinT2 < 1.0 && G4UniformRand() >= Fresnel(n1, n2, cosI)) {
+        G4double k = std::sqrt(1.0 - sinT2) - eta*cosI;
+        b.dx[i] = eta*b.dx[i] + k*nx;
+        b.dy[i] = eta*b.dy[i] + k*ny;
+        b.dz[i] = eta*b.dz[i] + k*nz;
+        return true;
+    }
+    // 정반사 (TIR 포함)
+    b.dx[i] -= 2*cosI*nx;
+    b.dy[i] -= 2*cosI*ny;
+    b.dz[i] -= 2*cosI*nz;
+    return false;
+}
+
+// 안쪽 법선 (nx,ny,nz) 기준 cosine 분포 반사
+void PhotonBatchEngine::LambertianAbout(std::size_t i, G4double nx, G4double ny, G4double nz)
+{
+    G4ThreeVector n(nx, ny, nz);
+    G4ThreeVector a = n.orthogonal().unit();
+    G4ThreeVector c = n.cross(a);
+
+    G4double cosT = std::sqrt(G4UniformRand());
+    G4double sinT = std::sqrt(1.0 - cosT*cosT);
+    G4double phi  = CLHEP::twopi * G4UniformRand();
+    G4ThreeVector d = sinT*std::cos(phi)*a + sinT*std::sin(phi)*c + cosT*n;
+
+    fBatch.dx[i] = d.x(); fBatch.dy[i] = d.y(); fBatch.dz[i] = d.z();
+}
+
+// ----------------------------------------------------------------------
+// genstep → 배치 광자 생성 (G4Scintillation 과 같은 방식: 스텝 위 균일,
+// 등방 방향, 방출 스펙트럼, 상승/감쇠 시간)
+// ----------------------------------------------------------------------
+std::size_t PhotonBatchEngine::FillBatch(std::size_t& gsIndex, G4int& gsOffset)
+{
+    auto& b = fBatch;
+    std::size_t n = 0;
+    const std::size_t nMax = b.x.size();
+
+    while (n < nMax && gsIndex < fGensteps.size()) {
+        const auto& gs = fGensteps[gsIndex];
+        G4int take = std::min<G4int>(gs.nPhotons - gsOffset, G4int(nMax - n));
+        for (G4int k = 0; k < take; k++, n++) {
+            G4double u = G4UniformRand();
+            G4ThreeVector p = gs.x0 + u*(gs.x1 - gs.x0);
+            b.x[n] = p.x(); b.y[n] = p.y(); b.z[n] = p.z();
+
+            G4double cost = 1.0 - 2.0*G4UniformRand();
+            G4double sint = std::sqrt(1.0 - cost*cost);
+            G4double phi  = CLHEP::twopi * G4UniformRand();
+            b.dx[n] = sint*std::cos(phi);
+            b.dy[n] = sint*std::sin(phi);
+            b.dz[n] = cost;
+
+            // 상승+감쇠 두 지수의 합성곱 = G4 bi-exponential 시간 분포
+            b.t[n] = gs.t0 + u*(gs.t1 - gs.t0)
+                   - fRiseTime*G4Log(G4UniformRand())
+                   - fDecayTime*G4Log(G4UniformRand());
+            b.e[n] = SampleTable(fScintCDF, fEnergies);
+            b.region[n]  = kScint;
+            b.segment[n] = gs.segment;
+        }
+        gsOffset += take;
+        if (gsOffset >= gs.nPhotons) { gsIndex++; gsOffset = 0; }
+    }
+    return n;
+}
+
+std::size_t PhotonBatchEngine::Compact(std::size_t n)
+{
+    auto& b = fBatch;
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        if (b.region[i] == kDead) continue;
+        if (k != i) {
+            b.x[k] = b.x[i]; b.y[k] = b.y[i]; b.z[k] = b.z[i];
+            b.dx[k] = b.dx[i]; b.dy[k] = b.dy[i]; b.dz[k] = b.dz[i];
+            b.t[k] = b.t[i]; b.e[k] = b.e[i];
+            b.region[k] = b.region[i]; b.segment[k] = b.segment[i];
+        }
+        k++;
+    }
+    return k;
+}
+
+// ----------------------------------------------------------------------
+// 경계까지 거리 (ray-box / ray-cylinder). 분기 없는 형태로 작성해
+// 컴파일러 자동 벡터화가 가능하도록 SoA 배열을 한 번에 훑는다.
+// ----------------------------------------------------------------------
+void PhotonBatchEngine::ComputeDistances(std::size_t n)
+{
+    auto& b = fBatch;
+    const G4double hx = fHalfX, hy = fHalfY, hz = fHalfZ;
+    const G4double gx0 = fGrooveXmin, gy = fGrooveHalfY;
+    const G4double fx = fFiberX, r2 = fRClad*fRClad;
+
+    for (std::size_t i = 0; i < n; i++) {
+        const G4double x = b.x[i], y = b.y[i], z = b.z[i];
+        const G4double dx = b.dx[i], dy = b.dy[i], dz = b.dz[i];
+        const G4double ix = (std::fabs(dx) > 1e-12) ? 1.0/dx : kInf;
+        const G4double iy = (std::fabs(dy) > 1e-12) ? 1.0/dy : kInf;
+        const G4double iz = (std::fabs(dz) > 1e-12) ? 1.0/dz : kInf;
+
+        // 바깥 박스 / groove 박스 공통 z 출구
+        const G4double tz = (dz > 0 ? (hz - z) : (-hz - z)) * iz;
+        const G4int    fz = (dz > 0) ? kScintPlusZ : kScintMinusZ;
+
+        // --- 신틸 영역: 바깥 박스 출구 ---
+        const G4double tox = (dx > 0 ? (hx - x) : (-hx - x)) * ix;
+        const G4double toy = (dy > 0 ? (hy - y) : (-hy - y)) * iy;
+        G4double tS = tox; G4int fS = (dx > 0) ? kScintPlusX : kScintMinusX;
+        if (toy < tS) { tS = toy; fS = (dy > 0) ? kScintPlusY : kScintMinusY; }
+        if (tz  < tS) { tS = tz;  fS = fz; }
+
+        // --- 신틸 영역: groove 박스 진입 (slab) ---
+        const G4double ax = (gx0 - x)*ix, bx = (hx - x)*ix;
+        const G4double ay = (-gy - y)*iy, by = (gy - y)*iy;
+        const G4double nearX = std::min(ax, bx), farX = std::max(ax, bx);
+        const G4double nearY = std::min(ay, by), farY = std::max(ay, by);
+        const G4double tNear = std::max(nearX, nearY);
+        const G4double tFar  = std::min(std::min(farX, farY), tz);
+        const G4bool   hitG  = (tNear > kEps) && (tNear < tFar) && (tNear < tS);
+        if (hitG) { tS = tNear; fS = (nearX > nearY) ? kGrooveWallX : kGrooveWallY; }
+
+        // --- glue 영역: groove 박스 출구 ---
+        G4double tG = farX; G4int fG = (dx > 0) ? kGluePlusX : kGlueToScintX;
+        if (farY < tG) { tG = farY; fG = kGlueToScintY; }
+        if (tz   < tG) { tG = tz;   fG = (dz > 0) ? kGluePlusZ : kGlueMinusZ; }
+
+        // --- glue 영역: 파이버(clad) 원통 진입 ---
+        const G4double px = x - fx;
+        const G4double a  = dx*dx + dy*dy;
+        const G4double bb = px*dx + y*dy;
+        const G4double c  = px*px + y*y - r2;
+        const G4double disc = bb*bb - a*c;
+        const G4double tC = (a > 1e-12 && disc > 0 && c > 0)
+                          ? (-bb - std::sqrt(disc)) / a : kInf;
+        if (tC > kEps && tC < tG) { tG = tC; fG = kFiber; }
+
+        const G4bool inScint = (b.region[i] == kScint);
+        b.dist[i] = inScint ? tS : tG;
+        b.face[i] = inScint ? fS : fG;
+    }
+}
+
+// ----------------------------------------------------------------------
+// 이동 + 벌크 흡수 + 경계 처리
+// ----------------------------------------------------------------------
+void PhotonBatchEngine::HandleInteractions(std::size_t n, std::vector<Arrival>& arrivals)
+{
+    auto& b = fBatch;
+    const G4double R = fReflectivity;
+
+    for (std::size_t i = 0; i < n; i++) {
+        const G4bool inScint = (b.region[i] == kScint);
+        const G4double d   = b.dist[i];
+        const G4double nM  = inScint ? fNScint : fNGlue;
+        const G4double abs = inScint ? fAbsScint : fAbsGlue;
+
+        if (d >= kInf || G4UniformRand() > G4Exp(-d/abs)) { b.region[i] = kDead; continue; }
+
+        b.x[i] += d*b.dx[i]; b.y[i] += d*b.dy[i]; b.z[i] += d*b.dz[i];
+        b.t[i] += d*nM/CLHEP::c_light;
+
+        switch (b.face[i]) {
+            // 테플론 랩핑: 반사율 R 로 Lambertian 반사, 나머지는 흡수
+            case kScintMinusX: case kScintPlusX: case kScintMinusY:
+            case kScintPlusY:  case kScintMinusZ:
+            case kGluePlusX:   case kGlueMinusZ: {
+                if (G4UniformRand() >= R) { b.region[i] = kDead; break; }
+                G4double nx = 0, ny = 0, nz = 0;
+                switch (b.face[i]) {
+                    case kScintMinusX: nx = +1; break;
+                    case kScintPlusX:
+                    case kGluePlusX:   nx = -1; break;
+                    case kScintMinusY: ny = +1; break;
+                    case kScintPlusY:  ny = -1; break;
+                    default:           nz = +1; break;
+                }
+                LambertianAbout(i, nx, ny, nz);
+                break;
+            }
+            // +Z 끝면: 랩핑 없음 → 공기와 Fresnel/TIR, 투과 시 손실
+            case kScintPlusZ:
+                if (RefractOrReflect(i, fNScint, fNAir, 0, 0, 1)) b.region[i] = kDead;
+                break;
+            case kGluePlusZ:
+                if (RefractOrReflect(i, fNGlue, fNAir, 0, 0, 1)) b.region[i] = kDead;
+                break;
+            // 신틸 → glue (groove 벽)
+            case kGrooveWallX:
+                if (RefractOrReflect(i, fNScint, fNGlue, 1, 0, 0)) b.region[i] = kGlue;
+                break;
+            case kGrooveWallY:
+                if (RefractOrReflect(i, fNScint, fNGlue, 0, (b.y[i] > 0 ? -1 : 1), 0))
+                    b.region[i] = kGlue;
+                break;
+            // glue → 신틸
+            case kGlueToScintX:
+                if (RefractOrReflect(i, fNGlue, fNScint, -1, 0, 0)) b.region[i] = kScint;
+                break;
+            case kGlueToScintY:
+                if (RefractOrReflect(i, fNGlue, fNScint, 0, (b.y[i] > 0 ? 1 : -1), 0))
+                    b.region[i] = kScint;
+                break;
+            case kFiber:
+                HandleFiber(i, arrivals);
+                break;
+            default:
+                b.region[i] = kDead;
+                break;
+        }
+
+        // 경계에서 약간 밀어 다음 거리 계산이 같은 면을 다시 잡지 않도록
+        if (b.region[i] != kDead) {
+            b.x[i] += kEps*b.dx[i]; b.y[i] += kEps*b.dy[i]; b.z[i] += kEps*b.dz[i];
+        }
+    }
+}
+
+// ----------------------------------------------------------------------
+// 파이버 처리
+//  - glue→clad Fresnel, core 코드 길이에 대한 WLS 흡수 확률
+//  - WLS 재방출 광자의 포획은 이상적 원통에서 보존되는 입사각으로 판정
+//    (core/clad TIR → core 포획, clad/glue TIR → clad 포획)
+//  - 포획 광자는 남은 축 방향 거리/ cos(θ) 만큼 감쇠시켜 +Z 끝에서
+//    coupling(glue) → SiPM 투과를 적용
+//  - 포획되지 않은/흡수되지 않은 광자는 파이버를 직진 통과한다고 근사
+// ----------------------------------------------------------------------
+void PhotonBatchEngine::HandleFiber(std::size_t i, std::vector<Arrival>& arrivals)
+{
+    auto& b = fBatch;
+    const G4ThreeVector d0(b.dx[i], b.dy[i], b.dz[i]);
+    const G4double px = b.x[i] - fFiberX, py = b.y[i];
+    const G4double pr = std::sqrt(px*px + py*py);
+
+    // glue → clad (법선: 파이버 축 방향 = 진행 방향 쪽)
+    if (!RefractOrReflect(i, fNGlue, fNClad, -px/pr, -py/pr, 0)) return;
+
+    G4ThreeVector d(b.dx[i], b.dy[i], b.dz[i]);
+
+    // 원통(xy) 교차: 시작점 (qx,qy), 반지름 r → 가까운/먼 근
+    auto Chord = [&](G4double qx, G4double qy, const G4ThreeVector& v, G4double r,
+                     G4double& tIn, G4double& tOut) -> G4bool {
+        G4double a = v.x()*v.x() + v.y()*v.y();
+        if (a < 1e-12) return false;
+        G4double bb = qx*v.x() + qy*v.y();
+        G4double c  = qx*qx + qy*qy - r*r;
+        G4double disc = bb*bb - a*c;
+        if (disc <= 0) return false;
+        tIn  = (-bb - std::sqrt(disc)) / a;
+        tOut = (-bb + std::sqrt(disc)) / a;
+        return tOut > 0;
+    };
+
+    G4double tIn = 0, tOut = 0;
+    G4bool absorbed = false;
+    G4ThreeVector q;
+    G4double t = b.t[i];
+
+    if (Chord(px, py, d, fRCore, tIn, tOut) && tIn > 0) {
+        G4double chord = tOut - tIn;
+        G4double lwls  = Interpolate(fEnergies, fWLSAbs, b.e[i]);
+        G4double s     = -lwls * G4Log(G4UniformRand());
+        if (s < chord) {
+            absorbed = true;
+            G4double path = tIn + s;
+            q = G4ThreeVector(b.x[i], b.y[i], b.z[i]) + path*d;
+            t += tIn*fNClad/CLHEP::c_light + s*fNCore/CLHEP::c_light;
+        }
+    }
+
+    if (!absorbed) {
+        // 파이버 통과: clad 먼 쪽 면으로 이동, 원래 방향 유지
+        G4double a0 = 0, a1 = 0;
+        Chord(px, py, d, fRClad, a0, a1);
+        G4double s = std::max(a1, 0.0);
+        b.x[i] += s*d.x(); b.y[i] += s*d.y(); b.z[i] += s*d.z();
+        b.t[i] += s*fNClad/CLHEP::c_light;
+        b.dx[i] = d0.x(); b.dy[i] = d0.y(); b.dz[i] = d0.z();
+        if (b.z[i] > fHalfZ || b.z[i] < -fHalfZ) b.region[i] = kDead;
+        return;
+    }
+
+    // --- WLS 재방출 ---
+    b.region[i] = kDead;
+    G4double E = SampleTable(fWLSEmitCDF, fEnergies);
+    t -= fWLSTime * G4Log(G4UniformRand());
+
+    G4double cost = 1.0 - 2.0*G4UniformRand();
+    G4double sint = std::sqrt(1.0 - cost*cost);
+    G4double phi  = CLHEP::twopi * G4UniformRand();
+    G4ThreeVector w(sint*std::cos(phi), sint*std::sin(phi), cost);
+
+    const G4double qx = q.x() - fFiberX, qy = q.y();
+    G4double nIn = fNCore, absLen = fAbsCore;
+    G4bool trapped = false;
+
+    if (Chord(qx, qy, w, fRCore, tIn, tOut)) {
+        G4double wx = qx + tOut*w.x(), wy = qy + tOut*w.y();
+        G4double cosI = std::fabs((wx*w.x() + wy*w.y()) / fRCore);
+        G4double sinI2 = 1.0 - cosI*cosI;
+        if (sinI2 >= (fNClad/fNCore)*(fNClad/fNCore)) {
+            trapped = true;
+        } else {
+            // core → clad 굴절 후 clad/glue 경계 입사각
+            G4double eta = fNCore/fNClad;
+            G4double k = std::sqrt(1.0 - eta*eta*sinI2) - eta*cosI;
+            G4ThreeVector nr(wx/fRCore, wy/fRCore, 0);
+            G4ThreeVector wc = eta*w + k*nr;
+            G4double c0 = 0, c1 = 0;
+            if (Chord(wx, wy, wc, fRClad, c0, c1)) {
+                G4double vx = wx + c1*wc.x(), vy = wy + c1*wc.y();
+                G4double cosO = std::fabs((vx*wc.x() + vy*wc.y()) / fRClad);
+                if (1.0 - cosO*cosO >= (fNGlue/fNClad)*(fNGlue/fNClad)) {
+                    trapped = true; nIn = fNClad; absLen = fAbsClad; w = wc;
+                }
+            }
+        }
+    } else {
+        trapped = true; // 축과 평행
+    }
+    if (!trapped) return;
+
+    G4double cosAx = std::fabs(w.z());
+    if (cosAx < 1e-6) return;
+
+    G4double path = 0;
+    if (w.z() > 0) {
+        path = (fFiberZmax - q.z()) / cosAx;
+    } else {
+        // -Z 끝: 테플론 Lambertian 반사 후 자오선 근사로 재포획 판정
+        path = (q.z() - fFiberZmin) / cosAx;
+        if (G4UniformRand() >= fReflectivity) return;
+        cosAx = std::sqrt(G4UniformRand());
+        G4double sinAx2 = 1.0 - cosAx*cosAx;
+        if (sinAx2 > 1.0 - (fNClad/fNCore)*(fNClad/fNCore)) return;
+        nIn = fNCore; absLen = fAbsCore;
+        path += (fFiberZmax - fFiberZmin) / cosAx;
+    }
+
+    G4double lwls = Interpolate(fEnergies, fWLSAbs, E);
+    if (G4UniformRand() > G4Exp(-path*(1.0/absLen + 1.0/lwls))) return;
+    t += path*nIn/CLHEP::c_light;
+
+    // +Z 끝면: 파이버 → coupling glue → SiPM
+    G4double T1 = 1.0 - Fresnel(nIn, fNGlue, cosAx);
+    G4double sin2 = (nIn/fNGlue)*(nIn/fNGlue)*(1.0 - cosAx*cosAx);
+    if (sin2 >= 1.0) return;
+    G4double cos2 = std::sqrt(1.0 - sin2);
+    G4double T2 = 1.0 - Fresnel(fNGlue, fNSi, cos2);
+    if (G4UniformRand() >= T1*T2) return;
+    t += fCoupT*fNGlue/(CLHEP::c_light*cos2);
+
+    arrivals.push_back({E, t, b.segment[i]});
+}
+
+// ----------------------------------------------------------------------
+void PhotonBatchEngine::Propagate(std::vector<Arrival>& arrivals)
+{
+    auto run = G4RunManager::GetRunManager()->GetCurrentRun();
+    const G4int runID = run ? run->GetRunID() : fRunID;
+    if (!fInitialized || runID != fRunID) {
+        Initialize();
+        fRunID = runID;
+    }
+    if (fBatch.x.size() != std::size_t(fBatchSize)) fBatch.Resize(fBatchSize);
+
+    std::size_t gsIndex = 0;
+    G4int gsOffset = 0;
+    fNPropagated = fNTruncated = 0;
+    while (gsIndex < fGensteps.size()) {
+        std::size_t n = FillBatch(gsIndex, gsOffset);
+        fNPropagated += n;
+        for (G4int iter = 0; n > 0 && iter < kMaxInteractions; iter++) {
+            ComputeDistances(n);
+            HandleInteractions(n, arrivals);
+            n = Compact(n);
+        }
+        // 한도까지 살아 있는 광자는 강제 종료 (다음 배치가 덮어씀) → 런 끝에 보고
+        fNTruncated += n;
+    }
+    Clear();
+}
@@ -0,0 +1,34 @@
+#include "PhotonTrackInformation.hh"
+
+#include "G4Material.hh"
+#include "G4ios.hh"
+
+namespace {
+    // DetectorConstruction 의 재질 이름 (Medium 순서)
+    const char* kMediumNames[PhotonTrackInformation::kNMedia] = {
+        "EJ212", "PS_Core", "PMMA_Clad", "OpticalGlue"
+    };
+}
+
+PhotonTrackInformation::PhotonTrackInformation()
+    : G4VUserTrackInformation("PhotonTrackInformation"),
+      fTau{0., 0., 0., 0.},
+      fNReflections(0)
+{}
+
+PhotonTrackInformation::~PhotonTrackInformation() {}
+
+G4int PhotonTrackInformation::MediumIndex(const G4Material* material)
+{
+    for (G4int i = 0; i < kNMedia; i++)
+        if (material->GetName() == kMediumNames[i]) return i;
+    return -1;
+}
+
+void PhotonTrackInformation::Print() const
+{
+    G4cout << "[PhotonTrackInformation] tau(scint, core, clad, glue) = "
+           << fTau[kScint] << ", " << fTau[kCore] << ", "
+           << fTau[kClad] << ", " << fTau[kGlue]
+           << "  teflon reflections = " << fNReflections << G4endl;
+}
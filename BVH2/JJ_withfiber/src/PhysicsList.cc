@@ -4,22 +4,65 @@
 #include "G4EmStandardPhysics.hh"
 #include "G4HadronPhysicsQGSP_BERT.hh"
 #include "G4OpticalPhysics.hh"
+#include "G4FastSimulationPhysics.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4GenericMessenger.hh"
+#include "G4RunManager.hh"
+#include "G4RegionStore.hh"
+#include "G4Region.hh"
+#include "G4UserLimits.hh"
+#include "G4UserSpecialCuts.hh"
+#include "G4PhysicsListHelper.hh"
+#include "G4Electron.hh"
+#include "G4Positron.hh"
+#include "PhotonBatchEngine.hh"
+#include "OpticalConfig.hh"
+#include "TabulatedBoundaryProcess.hh"
+#include "WrapReflectanceTable.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4ProcessManager.hh"
+#include "G4ParticleTable.hh"
+#include "FiberTransportModel.hh"
+#include "SegmentResponseModel.hh"
+
+#include <cfloat>
+
+namespace {
+    const char* kCutParticles[] = {"gamma", "e-", "e+", "proton"};
+
+    // 입자의 fast-simulation 프로세스 (fParameterisation) 활성/비활성
+    void SetFastSimulationActive(const char* particle, G4bool on)
+    {
+        auto definition = G4ParticleTable::GetParticleTable()->FindParticle(particle);
+        auto manager = definition ? definition->GetProcessManager() : nullptr;
+        if (!manager) return;
+        auto processes = manager->GetProcessList();
+        for (std::size_t i = 0; i < processes->size(); i++) {
+            auto process = (*processes)[i];
+            if (process->GetProcessType() == fParameterisation &&
+                manager->GetProcessActivation(process) != on)
+                manager->SetProcessActivation(process, on);
+        }
+    }
+}
 
 PhysicsList::PhysicsList()
-    : G4VModularPhysicsList()
+    : G4VModularPhysicsList(),
+      fSegmentCut(0.01 * mm), fFiberCut(0.01 * mm), fPassiveCut(0.01 * mm), fWorldCut(0.01 * mm)
 {
-    // 전역 컷값: 단위 mm
-    SetDefaultCutValue(0.01 * mm);
+    // 전역 컷값: 단위 mm (영역별 값은 SetCuts 에서)
+    SetDefaultCutValue(fWorldCut);
 
     // 1. 붕괴 물리
-    RegisterPhysics(new G4DecayPhysics());
+    fDecayPhysics = new G4DecayPhysics();
+    RegisterPhysics(fDecayPhysics);
 
     // 2. 전자기 물리
     RegisterPhysics(new G4EmStandardPhysics());
 
     // 3. 하드론 물리
-    RegisterPhysics(new G4HadronPhysicsQGSP_BERT());
+    fHadronPhysics = new G4HadronPhysicsQGSP_BERT();
+    RegisterPhysics(fHadronPhysics);
 
     // 4. 광학 물리
     auto opticalPhysics = new G4OpticalPhysics();
@@ -27,6 +70,211 @@ PhysicsList::PhysicsList()
     // (Scintillation / Cerenkov 포함)
     // Yield scaling은 MaterialPropertiesTable로 제어
     RegisterPhysics(opticalPhysics);
+
+    // 5. Fast simulation (파이버 광 수송 / 세그먼트 응답 테이블 모델)
+    //  프로세스는 등록만, 모델이 꺼진 입자는 런마다 비활성 (ApplyFastSimulationSwitches)
+    auto fastSimPhysics = new G4FastSimulationPhysics();
+    fastSimPhysics->ActivateFastSimulation("opticalphoton");
+    for (auto name : {"mu-", "mu+", "e-", "e+"})
+        fastSimPhysics->ActivateFastSimulation(name);
+    RegisterPhysics(fastSimPhysics);
+
+    // 광자 전파 엔진 선택 (마스터 전용 설정)
+    fMessenger = new G4GenericMessenger(this, "/veto/photon/", "Optical photon transport engine");
+    fMessenger->DeclareMethod("engine", &PhysicsList::SetPhotonEngine,
+                              "geant4 | batched | validate")
+        .SetCandidates("geant4 batched validate")
+        .SetToBeBroadcasted(false);
+    fMessenger->DeclareMethod("batchSize", &PhysicsList::SetPhotonBatchSize,
+                              "Photons per SoA batch in the batched engine")
+        .SetToBeBroadcasted(false);
+
+    fPresetMessenger = new G4GenericMessenger(this, "/veto/physics/", "Physics list preset");
+    fPresetMessenger->DeclareMethod("preset", &PhysicsList::SetPreset,
+                                    "lean (optical+EM) | decay (+decay) | full (+hadronic); before /run/initialize")
+        .SetCandidates("lean decay full")
+        .SetStates(G4State_PreInit)
+        .SetToBeBroadcasted(false);
+
+    fCutsMessenger = new G4GenericMessenger(this, "/veto/cuts/", "Per-region production cuts");
+    fCutsMessenger->DeclareMethodWithUnit("segment", "mm", &PhysicsList::SetSegmentCut,
+                                          "Production cut in the scintillator")
+        .SetToBeBroadcasted(false);
+    fCutsMessenger->DeclareMethodWithUnit("fiber", "mm", &PhysicsList::SetFiberCut,
+                                          "Production cut in glue, fiber, coupling and SiPM")
+        .SetToBeBroadcasted(false);
+    fCutsMessenger->DeclareMethodWithUnit("passive", "mm", &PhysicsList::SetPassiveCut,
+                                          "Production cut in the teflon wrapping")
+        .SetToBeBroadcasted(false);
+    fCutsMessenger->DeclareMethodWithUnit("world", "mm", &PhysicsList::SetWorldCut,
+                                          "Production cut in the world and segment envelopes")
+        .SetToBeBroadcasted(false);
+    fCutsMessenger->DeclareMethodWithUnit("eMinOutside", "keV", &PhysicsList::SetEMinOutside,
+                                          "Stop e+- below this kinetic energy outside the scintillator (0 = off)")
+        .SetToBeBroadcasted(false);
+
+    DefineOpticalCommands();
+}
+
+// /veto/optical/... : 값은 OpticalConfig (G4OpticalParameters, 프로세스 활성화, 스택 규칙)
+void PhysicsList::DefineOpticalCommands() {
+    fOpticalMessenger = new G4GenericMessenger(this, "/veto/optical/", "Optical process configuration");
+    fOpticalMessenger->DeclareMethod("cerenkov", &PhysicsList::SetCerenkov, "Cerenkov process on/off")
+        .SetToBeBroadcasted(false);
+    fOpticalMessenger->DeclareMethod("wls", &PhysicsList::SetWLS, "WLS process on/off")
+        .SetToBeBroadcasted(false);
+    fOpticalMessenger->DeclareMethod("cerenkovMaxPhotons", &PhysicsList::SetCerenkovMaxPhotons,
+                                     "Maximum Cerenkov photons per step")
+        .SetToBeBroadcasted(false);
+    fOpticalMessenger->DeclareMethod("cerenkovMaxBetaChange", &PhysicsList::SetCerenkovMaxBetaChange,
+                                     "Maximum beta change per step in percent")
+        .SetToBeBroadcasted(false);
+    fOpticalMessenger->DeclareMethod("trackSecondariesFirst", &PhysicsList::SetTrackSecondariesFirst,
+                                     "Suspend the parent and track Cerenkov/scintillation photons first")
+        .SetToBeBroadcasted(false);
+    fOpticalMessenger->DeclareMethod("photonStack", &PhysicsList::SetPhotonStack,
+                                     "urgent | waiting (optical photons after all charged tracks)"
+                                     " | staged (waiting in bounded batches)")
+        .SetCandidates("urgent waiting staged")
+        .SetToBeBroadcasted(false);
+    fOpticalMessenger->DeclareMethod("photonBatch", &PhysicsList::SetPhotonBatchLimit,
+                                     "Maximum waiting optical photons per event for photonStack staged")
+        .SetToBeBroadcasted(false);
+    auto& killCerenkovCmd = fOpticalMessenger->DeclareMethod("killCerenkovIn", &PhysicsList::SetKillCerenkovIn,
+                                     "Kill Cerenkov photons born in these materials / LV name prefixes (empty = none)");
+    killCerenkovCmd.SetParameterName("names", true);
+    killCerenkovCmd.SetDefaultValue("");
+    killCerenkovCmd.SetToBeBroadcasted(false);
+    auto& killWLSCmd = fOpticalMessenger->DeclareMethod("killWLSIn", &PhysicsList::SetKillWLSIn,
+                                     "Kill WLS photons born in these materials / LV name prefixes (empty = none)");
+    killWLSCmd.SetParameterName("names", true);
+    killWLSCmd.SetDefaultValue("");
+    killWLSCmd.SetToBeBroadcasted(false);
+    fOpticalMessenger->DeclareMethod("print", &PhysicsList::PrintOpticalConfig,
+                                     "Print the optical configuration")
+        .SetToBeBroadcasted(false);
+}
+
+// G4GenericMessenger 는 static 함수를 받지 않으므로 멤버로 전달
+void PhysicsList::SetCerenkov(G4bool on)                  { OpticalConfig::SetCerenkov(on); }
+void PhysicsList::SetWLS(G4bool on)                       { OpticalConfig::SetWLS(on); }
+void PhysicsList::SetCerenkovMaxPhotons(G4int n)          { OpticalConfig::SetCerenkovMaxPhotons(n); }
+void PhysicsList::SetCerenkovMaxBetaChange(G4double pct)  { OpticalConfig::SetCerenkovMaxBetaChange(pct); }
+void PhysicsList::SetTrackSecondariesFirst(G4bool on)     { OpticalConfig::SetTrackSecondariesFirst(on); }
+void PhysicsList::SetPhotonStack(const G4String& stack)   { OpticalConfig::SetPhotonStack(stack); }
+void PhysicsList::SetPhotonBatchLimit(G4int n)            { OpticalConfig::SetPhotonBatchLimit(n); }
+void PhysicsList::SetKillCerenkovIn(const G4String& list) { OpticalConfig::SetKillCerenkovIn(list); }
+void PhysicsList::SetKillWLSIn(const G4String& list)      { OpticalConfig::SetKillWLSIn(list); }
+void PhysicsList::PrintOpticalConfig()                    { OpticalConfig::Report(); }
+
+PhysicsList::~PhysicsList() {
+    delete fMessenger;
+    delete fCutsMessenger;
+    delete fPresetMessenger;
+    delete fOpticalMessenger;
+    delete fOutsideLimits;
+}
+
+// 빠진 constructor 는 등록 목록에서 제거 후 삭제 (PreInit 에서만 가능)
+void PhysicsList::SetPreset(const G4String& preset) {
+    const G4bool withDecay  = (preset != "lean");
+    const G4bool withHadron = (preset == "full");
+
+    if (withDecay && !fDecayPhysics) {
+        fDecayPhysics = new G4DecayPhysics();
+        RegisterPhysics(fDecayPhysics);
+    } else if (!withDecay && fDecayPhysics) {
+        RemovePhysics(fDecayPhysics);
+        delete fDecayPhysics;
+        fDecayPhysics = nullptr;
+    }
+
+    if (withHadron && !fHadronPhysics) {
+        fHadronPhysics = new G4HadronPhysicsQGSP_BERT();
+        RegisterPhysics(fHadronPhysics);
+    } else if (!withHadron && fHadronPhysics) {
+        RemovePhysics(fHadronPhysics);
+        delete fHadronPhysics;
+        fHadronPhysics = nullptr;
+    }
+    G4cout << "[PhysicsList] preset = " << preset << G4endl;
 }
 
-PhysicsList::~PhysicsList() {}
+// 신틸 밖 e± 최소 에너지: 한계값은 영역의 G4UserLimits, 적용은 e± 에만 등록한 프로세스
+void PhysicsList::ConstructProcess() {
+    G4VModularPhysicsList::ConstructProcess();
+
+    auto specialCuts = new G4UserSpecialCuts();
+    auto helper = G4PhysicsListHelper::GetPhysicsListHelper();
+    helper->RegisterProcess(specialCuts, G4Electron::Definition());
+    helper->RegisterProcess(specialCuts, G4Positron::Definition());
+
+    // 경계 프로세스 교체: 테플론 포장 lookup 테이블 (/veto/surface/wrapModel table, 초기화 전)
+    //  해석 모델이면 G4OpBoundaryProcess 그대로 (경계마다 표면 탐색 없음)
+    if (!WrapReflectanceTable::Instance()->IsRequested()) return;
+    auto photonManager = G4OpticalPhoton::Definition()->GetProcessManager();
+    auto boundary = photonManager->GetProcess("OpBoundary");
+    if (boundary) {
+        photonManager->RemoveProcess(boundary);
+        delete boundary;
+        photonManager->AddDiscreteProcess(new TabulatedBoundaryProcess());
+    }
+}
+
+void PhysicsList::ApplyFastSimulationSwitches() {
+    SetFastSimulationActive("opticalphoton", FiberTransportModel::IsEnabled());
+    for (auto name : {"mu-", "mu+", "e-", "e+"})
+        SetFastSimulationActive(name, SegmentResponseModel::IsEnabled());
+}
+
+void PhysicsList::SetCuts() {
+    SetDefaultCutValue(fWorldCut);
+    ApplyRegionCuts();
+}
+
+void PhysicsList::SetSegmentCut(G4double cut) { fSegmentCut = cut; ApplyRegionCuts(); }
+void PhysicsList::SetFiberCut(G4double cut)   { fFiberCut = cut;   ApplyRegionCuts(); }
+void PhysicsList::SetPassiveCut(G4double cut) { fPassiveCut = cut; ApplyRegionCuts(); }
+void PhysicsList::SetWorldCut(G4double cut)   { fWorldCut = cut;   SetCuts(); }
+void PhysicsList::SetEMinOutside(G4double ekin) { fEMinOutside = ekin; ApplyRegionCuts(); }
+
+// 영역은 DetectorConstruction::Construct 에서 생성 → 아직 없으면 다음 SetCuts 에서 적용
+void PhysicsList::ApplyRegionCuts() {
+    auto store = G4RegionStore::GetInstance();
+
+    const std::pair<const char*, G4double> regionCuts[] = {
+        {"SegmentRegion", fSegmentCut}, {"FiberRegion", fFiberCut},
+        {"ReadoutRegion", fFiberCut},   {"PassiveRegion", fPassiveCut}};
+    for (const auto& rc : regionCuts) {
+        if (!store->GetRegion(rc.first, false)) continue;
+        for (auto particle : kCutParticles) SetCutValue(rc.second, particle, rc.first);
+    }
+
+    // 0 이면 한계 없음 (G4UserSpecialCuts 가 바로 통과)
+    if (fEMinOutside > 0. && !fOutsideLimits)
+        fOutsideLimits = new G4UserLimits(DBL_MAX, DBL_MAX, DBL_MAX, fEMinOutside);
+    if (fOutsideLimits) fOutsideLimits->SetUserMinEkine(fEMinOutside);
+    G4UserLimits* limits = (fEMinOutside > 0.) ? fOutsideLimits : nullptr;
+    for (auto name : {"FiberRegion", "ReadoutRegion", "PassiveRegion", "DefaultRegionForTheWorld"}) {
+        auto region = store->GetRegion(name, false);
+        if (region) region->SetUserLimits(limits);
+    }
+
+    G4cout << "[Cuts] segment " << fSegmentCut/mm << " mm | fiber " << fFiberCut/mm
+           << " mm | passive " << fPassiveCut/mm << " mm | world " << fWorldCut/mm
+           << " mm | eMinOutside " << fEMinOutside/keV << " keV" << G4endl;
+}
+
+void PhysicsList::SetPhotonEngine(const G4String& mode) {
+    if (mode == "batched")       PhotonBatchEngine::SetMode(PhotonBatchEngine::kBatched);
+    else if (mode == "validate") PhotonBatchEngine::SetMode(PhotonBatchEngine::kValidate);
+    else                         PhotonBatchEngine::SetMode(PhotonBatchEngine::kGeant4);
+
+    // G4Scintillation 이 스택 플래그를 다시 읽도록
+    G4RunManager::GetRunManager()->PhysicsHasBeenModified();
+    G4cout << "[PhysicsList] photon engine = " << mode << G4endl;
+}
+
+void PhysicsList::SetPhotonBatchSize(G4int n) {
+    PhotonBatchEngine::SetBatchSize(n);
+}
@@ -5,6 +5,17 @@
 #include "G4Event.hh"
 #include "Randomize.hh"
 #include "CLHEP/Units/PhysicalConstants.h"
+#include "G4GenericMessenger.hh"
+#include "BetaSpectrum.hh"
+#include "CosmicMuonSpectrum.hh"
+#include "DetectorConstruction.hh"
+#include "EventAction.hh"
+#include "G4RunManager.hh"
+#include "G4EventManager.hh"
+#include "G4PrimaryVertex.hh"
+#include "PhaseSpace.hh"
+#include "BeamScan.hh"
+#include <algorithm>
 #include <cmath>
 
 // ====== 토글 매크로 ======
@@ -17,27 +28,222 @@
 // =========================
 
 PrimaryGeneratorAction::PrimaryGeneratorAction()
- : fParticleGun(nullptr)
+ : fParticleGun(nullptr),
+#ifdef USE_COSMIC_RAY
+   fMode(kCosmicMuon),
+#else
+   fMode(kSr90Beta),
+#endif
+   fPinned(false),
+   fPinEnergy(3.0 * GeV),
+   fPinPosition(-200.0 * mm, 0, 0),
+   fPinDirection(1, 0, 0),
+   fPinParticle(""),
+   fPinIsotropic(false),
+   fSkyEMin(1.0 * GeV),
+   fSkyEMax(10.0 * TeV),
+   fSkyMaxZenith(87.0 * deg)
 {
     fParticleGun = new G4ParticleGun(1);
+    // Sr-90 → Y-90 (Q 0.546 MeV), Y-90 → Zr-90 (Q 2.280 MeV): 둘 다 1차 금지 unique
+    fSr90Spectrum = new BetaSpectrum(39, 90, 0.546*MeV, BetaSpectrum::kUniqueFirstForbidden);
+    fY90Spectrum  = new BetaSpectrum(40, 90, 2.280*MeV, BetaSpectrum::kUniqueFirstForbidden);
+    DefineCommands();
 }
 
 PrimaryGeneratorAction::~PrimaryGeneratorAction()
 {
     delete fParticleGun;
+    delete fMessenger;
+    delete fSr90Spectrum;
+    delete fY90Spectrum;
+    delete fSkySpectrum;
 }
 
 // -------------------------
-// Sr-90 / Y-90 베타 에너지 샘플러 (단순 모델)
+// 런타임 설정 (/veto/gun/...)
+//  mode   : cosmic(μ-) | beta(Sr-90/Y-90 e-) | sky(해수면 μ± 스펙트럼)
+//           | replay(/veto/phasespace/replay 파일)
+//           — 기본값은 USE_COSMIC_RAY 토글
+//  pin*   : 해당 모드의 입자를 고정 에너지/위치/방향으로 발사 (응답 테이블 생성 등)
 // -------------------------
-G4double PrimaryGeneratorAction::SampleBetaEnergy(G4double Emax)
+void PrimaryGeneratorAction::DefineCommands()
+{
+    fMessenger = new G4GenericMessenger(this, "/veto/gun/", "Primary generator control");
+    fMessenger->DeclareMethod("mode", &PrimaryGeneratorAction::SetMode, "cosmic | beta | sky | replay")
+        .SetCandidates("cosmic beta sky replay");
+    fMessenger->DeclareProperty("pinned", fPinned,
+        "Fire the mode's particle with the pinned energy/position/direction");
+    fMessenger->DeclarePropertyWithUnit("pinEnergy", "MeV", fPinEnergy, "Pinned kinetic energy");
+    fMessenger->DeclarePropertyWithUnit("pinPosition", "mm", fPinPosition, "Pinned start position");
+    fMessenger->DeclareProperty("pinDirection", fPinDirection, "Pinned momentum direction");
+    fMessenger->DeclareProperty("pinParticle", fPinParticle,
+        "Pinned particle name (e.g. geantino, opticalphoton); empty = mode default");
+    fMessenger->DeclareProperty("pinIsotropic", fPinIsotropic,
+        "Pinned mode: isotropic direction from the pinned position");
+    fMessenger->DeclarePropertyWithUnit("skyEMin", "GeV", fSkyEMin, "Sky mode: minimum muon total energy");
+    fMessenger->DeclarePropertyWithUnit("skyEMax", "GeV", fSkyEMax, "Sky mode: maximum muon total energy");
+    fMessenger->DeclarePropertyWithUnit("skyMaxZenith", "deg", fSkyMaxZenith, "Sky mode: maximum zenith angle");
+    fMessenger->DeclareMethod("betaSource", &PrimaryGeneratorAction::SetBetaSource,
+        "Beta mode isotope: sr90y90 (equilibrium) | sr90 | y90")
+        .SetCandidates("sr90y90 sr90 y90");
+    fMessenger->DeclareMethod("betaValidate", &PrimaryGeneratorAction::ValidateBeta,
+        "Compare n table samples with the analytic beta spectra")
+        .SetToBeBroadcasted(false);
+}
+
+void PrimaryGeneratorAction::SetMode(const G4String& mode)
+{
+    fMode = (mode == "beta") ? kSr90Beta : (mode == "sky") ? kCosmicSky
+          : (mode == "replay") ? kReplay : kCosmicMuon;
+}
+
+void PrimaryGeneratorAction::SetBetaSource(const G4String& source)
+{
+    fSr90Fraction = (source == "sr90") ? 1.0 : (source == "y90") ? 0.0 : 0.5;
+}
+
+void PrimaryGeneratorAction::ValidateBeta(G4int n)
 {
-    while (true) {
-        G4double E = Emax * G4UniformRand();
-        G4double P = std::pow(1.0 - E / Emax, 2) * E * E;
-        G4double maxP = Emax * Emax;
-        if (G4UniformRand() * maxP < P) return E; // [MeV]
+    fSr90Spectrum->Validate("Sr-90", n);
+    fY90Spectrum->Validate("Y-90", n);
+}
+
+// -------------------------
+// Sr-90 / Y-90 베타 에너지 (BetaSpectrum 역 CDF 테이블, 난수 2개)
+// -------------------------
+G4double PrimaryGeneratorAction::SampleBetaEnergy()
+{
+    const BetaSpectrum* spectrum = (G4UniformRand() < fSr90Fraction) ? fSr90Spectrum : fY90Spectrum;
+    return spectrum->Sample();
+}
+
+// -------------------------
+// 해수면 뮤온 (sky 모드)
+//  천정 = -X (신틸 넓은 면이 하늘을 향함), 뮤온은 +X 방향으로 내려옴.
+//  방향마다 세그먼트 배열 bounding box 의 투영 면적 A(d) 위에서 시작점을
+//  고르므로 모든 광선이 배열에 닿는다. 배열을 지나는 뮤온의 방향 분포는
+//  I(E,θ)·A(d) 이므로 (E, d) 를 A(d)/A_max 로 기각 샘플 → 이벤트 가중치 없음
+//  (hNpe, 채널/효율/AdaptiveRun 그대로 유효). 이벤트 계수율 = Φ·<A(d)> 로 모두 같음
+//  → 런 평균이 절대 계수율 (RunAction [Cosmic]).
+// -------------------------
+void PrimaryGeneratorAction::GenerateSkyMuon(G4Event* anEvent)
+{
+    const G4double cosMin = std::cos(fSkyMaxZenith);
+    if (!fSkySpectrum || !fSkySpectrum->Matches(fSkyEMin, fSkyEMax, cosMin)) {
+        delete fSkySpectrum;
+        fSkySpectrum = new CosmicMuonSpectrum(fSkyEMin, fSkyEMax, cosMin);
     }
+
+    G4ThreeVector pMin, pMax;
+    auto detector = static_cast<const DetectorConstruction*>(
+        G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+    detector->GetArrayBounds(pMin, pMax);
+    const G4ThreeVector size = pMax - pMin;
+    // 법선 축 k 인 면의 면적. A(d) = Σ face[k]·|d_k| ≤ |face| (Cauchy-Schwarz)
+    const G4double face[3] = {size.y()*size.z(), size.x()*size.z(), size.x()*size.y()};
+    const G4double areaMax = std::sqrt(face[0]*face[0] + face[1]*face[1] + face[2]*face[2]);
+
+    G4double energy, cost, area[3], projected;
+    G4ThreeVector dir;
+    do {
+        fSkySpectrum->Sample(energy, cost);
+        G4double sint = std::sqrt(std::max(0., 1. - cost*cost));
+        G4double phi  = 2.0*CLHEP::pi*G4UniformRand();
+        dir.set(cost, sint*std::cos(phi), sint*std::sin(phi));
+        for (G4int a = 0; a < 3; a++) area[a] = face[a]*std::fabs(dir[a]);
+        projected = area[0] + area[1] + area[2];
+    } while (G4UniformRand()*areaMax > projected);
+
+    // 투영 면적 비례로 면 선택, 면 위 균일 점 (빛이 들어오는 쪽 면)
+    G4double u = G4UniformRand()*projected;
+    G4int k = (u < area[0]) ? 0 : (u < area[0] + area[1]) ? 1 : 2;
+    G4ThreeVector entry;
+    for (G4int a = 0; a < 3; a++)
+        entry[a] = (a == k) ? (dir[k] > 0. ? pMin[k] : pMax[k]) : pMin[a] + G4UniformRand()*size[a];
+    // 볼록 box 의 입사면에서 -dir 로 물러나면 항상 바깥 (월드 여유 10 cm 안)
+    G4ThreeVector pos = entry - 1.0*mm*dir;
+
+    G4bool plus = G4UniformRand() < CosmicMuonSpectrum::kMuPlusOverMinus / (1. + CosmicMuonSpectrum::kMuPlusOverMinus);
+    fParticleGun->SetParticleDefinition(
+        G4ParticleTable::GetParticleTable()->FindParticle(plus ? "mu+" : "mu-"));
+    fParticleGun->SetParticlePosition(pos);
+    fParticleGun->SetParticleMomentumDirection(dir);
+    fParticleGun->SetParticleEnergy(energy - fParticleGun->GetParticleDefinition()->GetPDGMass());
+    fParticleGun->GeneratePrimaryVertex(anEvent);
+
+    // <A(d)> : φ 균일 → <|cosφ|> = <|sinφ|> = 2/π
+    const G4double meanArea = face[0]*fSkySpectrum->GetMeanCos()
+                            + (face[1] + face[2])*(2./CLHEP::pi)*fSkySpectrum->GetMeanSin();
+    G4double rate = fSkySpectrum->GetTotalIntensity() * meanArea;
+    // vertex 가중치 = 계수율 (Hz, phase-space 기록용). 모든 이벤트가 같은 값
+    anEvent->GetPrimaryVertex()->SetWeight(rate*s);
+    auto eventAction = static_cast<EventAction*>(
+        G4EventManager::GetEventManager()->GetUserEventAction());
+    if (eventAction) eventAction->SetPrimaryRate(rate);
+}
+
+// -------------------------
+// Phase-space 재생: 이벤트 번호 → 원본 이벤트 (mmap 레코드 그대로)
+//  입자마다 vertex 하나, 가중치 = 기록 가중치 × (재생 묶음 수 / 원본 이벤트 수)
+// -------------------------
+void PrimaryGeneratorAction::GenerateReplay(G4Event* anEvent)
+{
+    if (!PhaseSpace::IsReplayLoaded()) {
+        G4Exception("PrimaryGeneratorAction::GenerateReplay", "Gun001", FatalException,
+                    "replay mode needs /veto/phasespace/replay <file>");
+        return;
+    }
+    const PhaseSpace::Record *begin, *end;
+    PhaseSpace::GetReplayEvent(anEvent->GetEventID(), begin, end);
+    auto particleTable = G4ParticleTable::GetParticleTable();
+    const G4double scale = PhaseSpace::GetReplayWeightScale();
+    for (auto r = begin; r != end; ++r) {
+        auto particle = particleTable->FindParticle(r->pdg);
+        if (!particle) continue;
+        fParticleGun->SetParticleDefinition(particle);
+        fParticleGun->SetParticlePosition(G4ThreeVector(r->x, r->y, r->z)*mm);
+        fParticleGun->SetParticleMomentumDirection(G4ThreeVector(r->dx, r->dy, r->dz));
+        fParticleGun->SetParticleEnergy(r->ekin*MeV);
+        fParticleGun->SetParticleTime(r->time*ns);
+        fParticleGun->GeneratePrimaryVertex(anEvent);
+        anEvent->GetPrimaryVertex(anEvent->GetNumberOfPrimaryVertex() - 1)->SetWeight(r->weight*scale);
+    }
+    fParticleGun->SetParticleTime(0.);
+    // 원본이 sky 모드면 가중치 = 계수율 (Hz) → 절대 계수율 보고 유지
+    auto eventAction = static_cast<EventAction*>(
+        G4EventManager::GetEventManager()->GetUserEventAction());
+    if (eventAction && begin != end && PhaseSpace::ReplayHasRates())
+        eventAction->SetPrimaryRate(begin->weight*scale / s);
+}
+
+// -------------------------
+// 빔 스캔: 0번 세그먼트 신틸 입구면 (-X) 의 (y, z) 를 각 θ 로 지나는 직선,
+//  시작점은 배열 bounding box 1 mm 바깥 (월드 공기)
+// -------------------------
+void PrimaryGeneratorAction::GenerateBeamScan(G4Event* anEvent)
+{
+    G4int point = std::min(anEvent->GetEventID() / BeamScan::GetEventsPerPoint(),
+                           BeamScan::GetNumberOfPoints() - 1);
+    G4double y, z, theta;
+    BeamScan::GetPoint(point, y, z, theta);
+
+    auto detector = static_cast<const DetectorConstruction*>(
+        G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+    G4ThreeVector pMin, pMax;
+    detector->GetArrayBounds(pMin, pMax);
+    G4ThreeVector face = detector->GetSegmentPosition(0)
+                       + G4ThreeVector(-0.5*detector->GetScintSize().x(), y, z);
+    G4ThreeVector dir(std::cos(theta), 0., std::sin(theta));
+    G4ThreeVector pos = face - dir*((face.x() - (pMin.x() - 1.0*mm)) / dir.x());
+
+    const G4bool beta = (fMode == kSr90Beta);
+    fParticleGun->SetParticleDefinition(
+        G4ParticleTable::GetParticleTable()->FindParticle(beta ? "e-" : "mu-"));
+    fParticleGun->SetParticlePosition(pos);
+    fParticleGun->SetParticleMomentumDirection(dir);
+    fParticleGun->SetParticleEnergy(beta ? SampleBetaEnergy() : 3.0*GeV);
+    fParticleGun->GeneratePrimaryVertex(anEvent);
 }
 
 // -------------------------
@@ -75,77 +281,108 @@ void PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
     // 신틸레이터 입구면(10x140) 중심 좌표: x = -1 mm, y=z=0
     const G4ThreeVector target(-halfScintX, -2.0, 0.0);
 
-#ifdef USE_COSMIC_RAY
-    // ======================= 코스믹 뮤온 모드 =======================
-    // 콜리메이터는 사용하지 않음.
+    // ======================= 고정(pinned) 모드 =======================
+    if (fPinned) {
+        G4String name = !fPinParticle.empty() ? fPinParticle
+                      : (fMode == kCosmicMuon ? G4String("mu-") : G4String("e-"));
+        auto particle = G4ParticleTable::GetParticleTable()->FindParticle(name);
+        fParticleGun->SetParticleDefinition(particle);
+        fParticleGun->SetParticlePosition(fPinPosition);
+
+        G4ThreeVector dir = fPinDirection.unit();
+        if (fPinIsotropic) {
+            G4double cost = 1.0 - 2.0*G4UniformRand();
+            G4double sint = std::sqrt(1.0 - cost*cost);
+            G4double phi  = 2.0*CLHEP::pi*G4UniformRand();
+            dir.set(sint*std::cos(phi), sint*std::sin(phi), cost);
+        }
+        fParticleGun->SetParticleMomentumDirection(dir);
+        if (name == "opticalphoton") {
+            // 광학 광자는 편광 필요 (방향에 수직, 무작위 방위)
+            fParticleGun->SetParticlePolarization(
+                dir.orthogonal().unit().rotate(2.0*CLHEP::pi*G4UniformRand(), dir));
+        }
+        fParticleGun->SetParticleEnergy(fPinEnergy);
+        fParticleGun->GeneratePrimaryVertex(anEvent);
+        return;
+    }
+
+    if (BeamScan::IsActive()) {
+        GenerateBeamScan(anEvent);
+        return;
+    }
+
+    if (fMode == kReplay) {
+        GenerateReplay(anEvent);
+        return;
+    }
+
+    if (fMode == kCosmicSky) {
+        GenerateSkyMuon(anEvent);
+        return;
+    }
+
+    if (fMode == kCosmicMuon) {
+        // ======================= 코스믹 뮤온 모드 =======================
+        // 콜리메이터는 사용하지 않음.
 
-    // 입자 정의: μ-
-    G4ParticleDefinition* mu = G4ParticleTable::GetParticleTable()->FindParticle("mu-");
-    fParticleGun->SetParticleDefinition(mu);
+        // 입자 정의: μ-
+        G4ParticleDefinition* mu = G4ParticleTable::GetParticleTable()->FindParticle("mu-");
+        fParticleGun->SetParticleDefinition(mu);
 
-    // 시작 위치: 신틸레이터 위쪽(+z)에서 충분히 떨어진 곳 (예: z=+200 mm)
-    // x는 입구면과 같은 -1 mm에 두면 중심 조준 시 직관적임
-    // 필요하면 y,z 범위를 넓혀서 샘플링해도 됨.
-   G4ThreeVector posCosmic(-200.0 * mm, 0.0 * mm, 0.0 * mm);
+        // 시작 위치: 신틸레이터 위쪽(+z)에서 충분히 떨어진 곳 (예: z=+200 mm)
+        // x는 입구면과 같은 -1 mm에 두면 중심 조준 시 직관적임
+        // 필요하면 y,z 범위를 넓혀서 샘플링해도 됨.
+        G4ThreeVector posCosmic(-200.0 * mm, 0.0 * mm, 0.0 * mm);
 
 
-    // 방향
+        // 방향
 #ifdef PASS_THROUGH_CENTER
-    // 중앙을 정확히 지나가도록 조준
-    G4ThreeVector dirCosmic = AimDir(posCosmic, target);
+        // 중앙을 정확히 지나가도록 조준
+        G4ThreeVector dirCosmic = AimDir(posCosmic, target);
 #else
-    // 간단히 중앙을 향하되, 소량의 각 분산(예: 최대 5°)을 부여하려면 아래 주석 해제
-    // G4double maxTheta = 5.0 * deg;
-    // G4ThreeVector ideal = AimDir(posCosmic, target);
-    // // ideal을 중심으로 작은 원뿔 각 분포를 만들고 싶다면 회전 구현 필요(여기선 단순화)
-    // G4ThreeVector dirCosmic = ideal;
-    G4ThreeVector dirCosmic = AimDir(posCosmic, target);
+        // 간단히 중앙을 향하되, 소량의 각 분산(예: 최대 5°)을 부여하려면 아래 주석 해제
+        // G4double maxTheta = 5.0 * deg;
+        // G4ThreeVector ideal = AimDir(posCosmic, target);
+        // // ideal을 중심으로 작은 원뿔 각 분포를 만들고 싶다면 회전 구현 필요(여기선 단순화)
+        // G4ThreeVector dirCosmic = ideal;
+        G4ThreeVector dirCosmic = AimDir(posCosmic, target);
 #endif
 
-    fParticleGun->SetParticlePosition(posCosmic);
-    fParticleGun->SetParticleMomentumDirection(dirCosmic);
-    fParticleGun->SetParticleEnergy(3.0 * GeV); // 대표 MIP 뮤온 에너지
+        fParticleGun->SetParticlePosition(posCosmic);
+        fParticleGun->SetParticleMomentumDirection(dirCosmic);
+        fParticleGun->SetParticleEnergy(3.0 * GeV); // 대표 MIP 뮤온 에너지
 
-#else
-    // ======================= Sr-90 / Y-90 모드 (콜리메이터 적용) =======================
-    // 입자 정의: 전자
-    G4ParticleDefinition* electron = G4ParticleTable::GetParticleTable()->FindParticle("e-");
-    fParticleGun->SetParticleDefinition(electron);
+    } else {
+        // ======================= Sr-90 / Y-90 모드 (콜리메이터 적용) =======================
+        // 입자 정의: 전자
+        G4ParticleDefinition* electron = G4ParticleTable::GetParticleTable()->FindParticle("e-");
+        fParticleGun->SetParticleDefinition(electron);
 
-    // 콜리메이터 출구 원판 내부에서 균일한 (y,z) 위치 샘플
-    G4double r   = collimatorRadius * std::sqrt(G4UniformRand());
-    G4double phi = 2.0 * CLHEP::pi * G4UniformRand();
-    G4double y   = r * std::cos(phi);
-    G4double z   = r * std::sin(phi);
-    G4double x   = -(collimatorLength/2.0 + halfScintX); // 출구면 x
+        // 콜리메이터 출구 원판 내부에서 균일한 (y,z) 위치 샘플
+        G4double r   = collimatorRadius * std::sqrt(G4UniformRand());
+        G4double phi = 2.0 * CLHEP::pi * G4UniformRand();
+        G4double y   = r * std::cos(phi);
+        G4double z   = r * std::sin(phi);
+        G4double x   = -(collimatorLength/2.0 + halfScintX); // 출구면 x
 
-    G4ThreeVector pos(x, y, z);
+        G4ThreeVector pos(x, y, z);
 
-    // 방향
+        // 방향
 #ifdef PASS_THROUGH_CENTER
-    // 출구면 임의 위치 → 신틸 입구면 중앙으로 조준 (개구각 물리와 약간 불일치 가능)
-    G4ThreeVector dir = AimDir(pos, target);
+        // 출구면 임의 위치 → 신틸 입구면 중앙으로 조준 (개구각 물리와 약간 불일치 가능)
+        G4ThreeVector dir = AimDir(pos, target);
 #else
-    // 현실적: 콜리메이터 최대 반각 내에서 샘플
-    G4double maxTheta = std::atan(collimatorRadius / collimatorLength);
-    G4ThreeVector dir = SampleConeDirection(maxTheta);
+        // 현실적: 콜리메이터 최대 반각 내에서 샘플
+        G4double maxTheta = std::atan(collimatorRadius / collimatorLength);
+        G4ThreeVector dir = SampleConeDirection(maxTheta);
 #endif
 
-    // Sr-90 (50%) / Y-90 (50%) — 필요 시 Sr-90만 쓰려면 아래 분기 정리
-    if (G4UniformRand() < 0.5) {
-        // Sr-90: Emax ≈ 0.546 MeV
-        G4double E = SampleBetaEnergy(0.546);
+        // Sr-90 / Y-90 비율은 /veto/gun/betaSource (기본 50/50)
         fParticleGun->SetParticlePosition(pos);
         fParticleGun->SetParticleMomentumDirection(dir);
-        fParticleGun->SetParticleEnergy(E * MeV);
-    } else {
-        // Y-90: Emax ≈ 2.28 MeV
-        G4double E = SampleBetaEnergy(2.28);
-        fParticleGun->SetParticlePosition(pos);
-        fParticleGun->SetParticleMomentumDirection(dir);
-        fParticleGun->SetParticleEnergy(E * MeV);
+        fParticleGun->SetParticleEnergy(SampleBetaEnergy());
     }
-#endif
 
     // 발사
     fParticleGun->GeneratePrimaryVertex(anEvent);
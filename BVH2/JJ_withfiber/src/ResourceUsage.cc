@@ -0,0 +1,47 @@
+#include "ResourceUsage.hh"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <time.h>
+
+namespace ResourceUsage {
+
+G4double ResidentMemoryMB()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmRSS:") != 0) continue;
+        std::istringstream is(line.substr(6));
+        G4double kB = 0.;
+        is >> kB;
+        return kB / 1024.;
+    }
+
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0.;
+#ifdef __APPLE__
+    return usage.ru_maxrss / (1024. * 1024.);   // bytes
+#else
+    return usage.ru_maxrss / 1024.;             // kB
+#endif
+}
+
+G4double ProcessCpuSeconds()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0.;
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec
+         + 1e-6 * (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+G4double ThreadCpuSeconds()
+{
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) return 0.;
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+}
@@ -0,0 +1,24 @@
+#include "ResponseAccumulable.hh"
+
+ResponseAccumulable::ResponseAccumulable(const G4String& name)
+    : G4VAccumulable(name)
+{}
+
+void ResponseAccumulable::Fill(G4int npe, const std::vector<G4double>& hitTimes)
+{
+    fNpe.push_back(npe);
+    fTimes.insert(fTimes.end(), hitTimes.begin(), hitTimes.end());
+}
+
+void ResponseAccumulable::Merge(const G4VAccumulable& other)
+{
+    const auto& rhs = static_cast<const ResponseAccumulable&>(other);
+    fNpe.insert(fNpe.end(), rhs.fNpe.begin(), rhs.fNpe.end());
+    fTimes.insert(fTimes.end(), rhs.fTimes.begin(), rhs.fTimes.end());
+}
+
+void ResponseAccumulable::Reset()
+{
+    fNpe.clear();
+    fTimes.clear();
+}
@@ -0,0 +1,138 @@
+#include "ResponseTable.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace {
+    const char     kMagic[4] = {'V', 'R', 'T', '1'};
+    const G4double kTimeUnit = 0.01 * ns;
+
+    template <typename T>
+    void WriteVec(std::ofstream& out, const std::vector<T>& v) {
+        uint32_t n = v.size();
+        out.write(reinterpret_cast<const char*>(&n), sizeof(n));
+        out.write(reinterpret_cast<const char*>(v.data()), n*sizeof(T));
+    }
+
+    template <typename T>
+    void ReadVec(std::ifstream& in, std::vector<T>& v) {
+        uint32_t n = 0;
+        in.read(reinterpret_cast<char*>(&n), sizeof(n));
+        v.resize(n);
+        in.read(reinterpret_cast<char*>(v.data()), n*sizeof(T));
+    }
+}
+
+ResponseTable* ResponseTable::Instance()
+{
+    static ResponseTable instance;
+    return &instance;
+}
+
+void ResponseTable::SetGrid(const std::vector<G4double>& energies,
+                            const std::vector<G4double>& ys,
+                            const std::vector<G4double>& zs,
+                            const std::vector<G4double>& thetas)
+{
+    fEnergies = energies; fYs = ys; fZs = zs; fThetas = thetas;
+    fCells.assign(kNParticles * fEnergies.size() * fYs.size() * fZs.size() * fThetas.size(), Cell());
+}
+
+G4int ResponseTable::CellIndex(G4int particle, G4int iE, G4int iY, G4int iZ, G4int iT) const
+{
+    return (((particle*G4int(fEnergies.size()) + iE)*G4int(fYs.size()) + iY)
+            *G4int(fZs.size()) + iZ)*G4int(fThetas.size()) + iT;
+}
+
+G4int ResponseTable::Nearest(const std::vector<G4double>& axis, G4double v)
+{
+    G4int best = 0;
+    for (G4int i = 1; i < G4int(axis.size()); i++)
+        if (std::fabs(axis[i] - v) < std::fabs(axis[best] - v)) best = i;
+    return best;
+}
+
+G4int ResponseTable::FindCell(G4int particle, G4double energy, G4double y, G4double z,
+                              G4double theta) const
+{
+    // 에너지는 로그 간격 격자 가정 → log 공간에서 최근접
+    G4int iE = 0;
+    if (energy <= 0.) energy = fEnergies.front();
+    for (G4int i = 1; i < G4int(fEnergies.size()); i++)
+        if (std::fabs(std::log(fEnergies[i]/energy)) < std::fabs(std::log(fEnergies[iE]/energy))) iE = i;
+    return CellIndex(particle, iE, Nearest(fYs, y), Nearest(fZs, z), Nearest(fThetas, theta));
+}
+
+// ----------------------------------------------------------------------
+// 분위수 압축
+// ----------------------------------------------------------------------
+void ResponseTable::FillCell(G4int cell, std::vector<G4int>& npe, std::vector<G4double>& times)
+{
+    Cell& c = fCells[cell];
+    c.nEvents = npe.size();
+    if (npe.empty()) return;
+
+    std::sort(npe.begin(), npe.end());
+    std::sort(times.begin(), times.end());
+
+    G4double sum = 0;
+    for (auto n : npe) sum += n;
+    c.meanNpe = sum / npe.size();
+
+    for (G4int k = 0; k < kNQuantiles; k++) {
+        G4double u = G4double(k) / (kNQuantiles - 1);
+        c.npeQ[k] = std::min(npe[std::size_t(u*(npe.size() - 1) + 0.5)], 65535);
+        if (!times.empty()) {
+            G4double t = times[std::size_t(u*(times.size() - 1) + 0.5)] / kTimeUnit;
+            c.timeQ[k] = uint16_t(std::min(std::max(t, 0.), 65535.));
+        }
+    }
+}
+
+G4int ResponseTable::SampleNpe(G4int cell) const
+{
+    const Cell& c = fCells[cell];
+    G4double x = G4UniformRand() * (kNQuantiles - 1);
+    G4int k = std::min(G4int(x), kNQuantiles - 2);
+    G4double f = x - k;
+    G4double v = (1-f)*c.npeQ[k] + f*c.npeQ[k+1];
+    return G4int(v + G4UniformRand()); // 확률적 반올림
+}
+
+G4double ResponseTable::SampleTime(G4int cell) const
+{
+    const Cell& c = fCells[cell];
+    G4double x = G4UniformRand() * (kNQuantiles - 1);
+    G4int k = std::min(G4int(x), kNQuantiles - 2);
+    G4double f = x - k;
+    return ((1-f)*c.timeQ[k] + f*c.timeQ[k+1]) * kTimeUnit;
+}
+
+// ----------------------------------------------------------------------
+// 이진 파일 입출력
+// ----------------------------------------------------------------------
+G4bool ResponseTable::Write(const G4String& fileName) const
+{
+    std::ofstream out(fileName, std::ios::binary);
+    if (!out) return false;
+    out.write(kMagic, 4);
+    WriteVec(out, fEnergies); WriteVec(out, fYs);
+    WriteVec(out, fZs);       WriteVec(out, fThetas);
+    WriteVec(out, fCells);
+    return out.good();
+}
+
+G4bool ResponseTable::Read(const G4String& fileName)
+{
+    std::ifstream in(fileName, std::ios::binary);
+    char magic[4] = {};
+    if (!in || !in.read(magic, 4) || !std::equal(magic, magic + 4, kMagic)) return false;
+    ReadVec(in, fEnergies); ReadVec(in, fYs);
+    ReadVec(in, fZs);       ReadVec(in, fThetas);
+    ReadVec(in, fCells);
+    return in.good();
+}
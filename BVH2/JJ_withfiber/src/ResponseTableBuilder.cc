@@ -0,0 +1,205 @@
+#include "ResponseTableBuilder.hh"
+#include "ResponseTable.hh"
+#include "SegmentResponseModel.hh"
+#include "DetectorConstruction.hh"
+
+#include "G4GenericMessenger.hh"
+#include "G4RunManager.hh"
+#include "G4UImanager.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VSolid.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <cmath>
+#include <sstream>
+
+G4bool ResponseTableBuilder::fCollecting = false;
+G4int  ResponseTableBuilder::fCurrentCell = -1;
+
+namespace {
+    std::vector<G4double> ParseList(const G4String& list, G4double unit)
+    {
+        std::vector<G4double> v;
+        std::istringstream is(list);
+        G4double x;
+        while (is >> x) v.push_back(x * unit);
+        return v;
+    }
+
+    G4String Vec3(const G4ThreeVector& v)
+    {
+        std::ostringstream os;
+        os << v.x() << " " << v.y() << " " << v.z();
+        return os.str();
+    }
+}
+
+ResponseTableBuilder::ResponseTableBuilder()
+    : fMessenger(nullptr),
+      fEnergies{1.*MeV, 2.*MeV, 1.*GeV},
+      fYs{-4.*mm, -2.*mm, 0., 2.*mm, 4.*mm},
+      fZs{-60.*mm, -30.*mm, 0., 30.*mm, 60.*mm},
+      fThetas{0.},
+      fParticles{ResponseTable::kMuon, ResponseTable::kBeta},
+      fEventsPerCell(200),
+      fBuilding(false),
+      fFastSimWasOn(false),
+      fHalfX(1.0*mm)
+{
+    DefineCommands();
+}
+
+ResponseTableBuilder::~ResponseTableBuilder()
+{
+    delete fMessenger;
+}
+
+void ResponseTableBuilder::DefineCommands()
+{
+    fMessenger = new G4GenericMessenger(this, "/veto/response/", "Segment response tables");
+    fMessenger->DeclareMethod("energies", &ResponseTableBuilder::SetEnergies,
+                              "Kinetic energy grid in MeV (space separated)");
+    fMessenger->DeclareMethod("ys", &ResponseTableBuilder::SetYs,
+                              "Entry y grid on the scintillator face in mm");
+    fMessenger->DeclareMethod("zs", &ResponseTableBuilder::SetZs,
+                              "Entry z grid on the scintillator face in mm");
+    fMessenger->DeclareMethod("thetas", &ResponseTableBuilder::SetThetas,
+                              "Incident angle grid in deg (tilt in the x-z plane)");
+    fMessenger->DeclareMethod("particles", &ResponseTableBuilder::SetParticles,
+                              "muon | beta | both").SetCandidates("muon beta both");
+    fMessenger->DeclareProperty("eventsPerCell", fEventsPerCell,
+                                "Full-simulation events per grid cell");
+    fMessenger->DeclareMethod("begin", &ResponseTableBuilder::Begin,
+                              "Start a table: set the grid, pin the gun, define loop aliases")
+        .SetToBeBroadcasted(false);
+    fMessenger->DeclareMethod("cell", &ResponseTableBuilder::SelectCell,
+                              "Aim the gun at cell index (0 .. {responseLastCell}) for the next run")
+        .SetToBeBroadcasted(false);
+    fMessenger->DeclareMethod("write", &ResponseTableBuilder::Write,
+                              "Unpin the gun and write the filled table to a file")
+        .SetToBeBroadcasted(false);
+    fMessenger->DeclareMethod("load", &ResponseTableBuilder::Load,
+                              "Load a table for the segment fast simulation");
+    fMessenger->DeclareMethod("fastSim", &ResponseTableBuilder::SetFastSim,
+                              "Sample segment response from the loaded table");
+}
+
+void ResponseTableBuilder::SetEnergies(const G4String& list) { fEnergies = ParseList(list, MeV); }
+void ResponseTableBuilder::SetYs(const G4String& list)       { fYs = ParseList(list, mm); }
+void ResponseTableBuilder::SetZs(const G4String& list)       { fZs = ParseList(list, mm); }
+void ResponseTableBuilder::SetThetas(const G4String& list)   { fThetas = ParseList(list, deg); }
+
+void ResponseTableBuilder::SetParticles(const G4String& which)
+{
+    fParticles.clear();
+    if (which != "beta") fParticles.push_back(ResponseTable::kMuon);
+    if (which != "muon") fParticles.push_back(ResponseTable::kBeta);
+}
+
+void ResponseTableBuilder::SetFastSim(G4bool on)
+{
+    if (on && !ResponseTable::Instance()->IsLoaded()) {
+        G4cout << "[Response] no table loaded; fast simulation stays off." << G4endl;
+        return;
+    }
+    SegmentResponseModel::SetEnabled(on);
+}
+
+// ----------------------------------------------------------------------
+// 테이블 시작: 격자 확정, 입구면 위치, 건 고정, 매크로 루프용 alias
+// ----------------------------------------------------------------------
+void ResponseTableBuilder::Begin()
+{
+    // 신틸 입구면 (-X) 위치: 신틸 LV 의 bounding box, 배열의 0번 세그먼트
+    fHalfX = 1.0*mm;
+    for (auto lv : *G4LogicalVolumeStore::GetInstance()) {
+        if (lv->GetName().find("ScintLV") != 0) continue;
+        G4ThreeVector pMin, pMax;
+        lv->GetSolid()->BoundingLimits(pMin, pMax);
+        fHalfX = -pMin.x();
+        break;
+    }
+    auto detector = dynamic_cast<const DetectorConstruction*>(
+        G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+    fOrigin = detector ? detector->GetSegmentPosition(0) : G4ThreeVector();
+
+    ResponseTable::Instance()->SetGrid(fEnergies, fYs, fZs, fThetas);
+
+    if (!fBuilding) fFastSimWasOn = SegmentResponseModel::IsEnabled();
+    SegmentResponseModel::SetEnabled(false);
+    G4UImanager::GetUIpointer()->ApplyCommand("/veto/gun/pinned true");
+    fBuilding = true;
+
+    const G4int nCells = fParticles.size()*fEnergies.size()*fYs.size()*fZs.size()*fThetas.size();
+    auto ui = G4UImanager::GetUIpointer();
+    ui->SetAlias(("responseLastCell " + std::to_string(nCells - 1)).c_str());
+    ui->SetAlias(("responseEvents " + std::to_string(fEventsPerCell)).c_str());
+    G4cout << "[Response] " << nCells << " cells x " << fEventsPerCell << " events" << G4endl;
+}
+
+// ----------------------------------------------------------------------
+// 루프 번호 → (입자, E, y, z, θ) 셀, 건 설정. 다음 BeamOn 이 이 셀을 채운다.
+//  번호 = (((ip*nE + iE)*nY + iY)*nZ + iZ)*nT + iT  (ip = particles 목록 순서)
+// ----------------------------------------------------------------------
+void ResponseTableBuilder::SelectCell(G4int index)
+{
+    const G4int nE = fEnergies.size(), nY = fYs.size(), nZ = fZs.size(), nT = fThetas.size();
+    const G4int nPer = nE*nY*nZ*nT;
+    if (!fBuilding || index < 0 || index >= G4int(fParticles.size())*nPer) {
+        G4cout << "[Response] cell " << index << " out of range (run /veto/response/begin first)." << G4endl;
+        fCollecting = false;
+        return;
+    }
+    const G4int p  = fParticles[index / nPer];
+    const G4int iT = index % nT;
+    const G4int iZ = (index / nT) % nZ;
+    const G4int iY = (index / (nT*nZ)) % nY;
+    const G4int iE = (index / (nT*nZ*nY)) % nE;
+
+    auto ui = G4UImanager::GetUIpointer();
+    const G4ThreeVector pos = fOrigin + G4ThreeVector(-fHalfX - 1.0*um, fYs[iY], fZs[iZ]);
+    const G4ThreeVector dir(std::cos(fThetas[iT]), 0., std::sin(fThetas[iT]));
+    ui->ApplyCommand(p == ResponseTable::kMuon ? "/veto/gun/mode cosmic" : "/veto/gun/mode beta");
+    ui->ApplyCommand("/veto/gun/pinEnergy " + std::to_string(fEnergies[iE]/MeV) + " MeV");
+    ui->ApplyCommand("/veto/gun/pinPosition " + Vec3(pos/mm) + " mm");
+    ui->ApplyCommand("/veto/gun/pinDirection " + Vec3(dir));
+
+    fCurrentCell = ResponseTable::Instance()->CellIndex(p, iE, iY, iZ, iT);
+    fCollecting = true;
+    G4cout << "[Response] cell " << fCurrentCell << (p == ResponseTable::kMuon ? " muon" : " beta")
+           << " E=" << fEnergies[iE]/MeV << " MeV y=" << fYs[iY]/mm << " z=" << fZs[iZ]/mm
+           << " theta=" << fThetas[iT]/deg << G4endl;
+}
+
+void ResponseTableBuilder::EndOfRun(std::vector<G4int> npe, std::vector<G4double> times)
+{
+    fCollecting = false;
+    auto table = ResponseTable::Instance();
+    table->FillCell(fCurrentCell, npe, times);
+    const auto& cell = table->GetCell(fCurrentCell);
+    G4cout << "[Response] cell " << fCurrentCell << " events=" << cell.nEvents
+           << " <npe>=" << cell.meanNpe << G4endl;
+}
+
+void ResponseTableBuilder::Write(const G4String& fileName)
+{
+    if (fBuilding) {
+        G4UImanager::GetUIpointer()->ApplyCommand("/veto/gun/pinned false");
+        SegmentResponseModel::SetEnabled(fFastSimWasOn);
+        fBuilding = false;
+    }
+    fCollecting = false;
+    if (ResponseTable::Instance()->Write(fileName))
+        G4cout << "[Response] table written to " << fileName << G4endl;
+    else
+        G4cout << "[Response] failed to write " << fileName << G4endl;
+}
+
+void ResponseTableBuilder::Load(const G4String& fileName)
+{
+    if (ResponseTable::Instance()->Read(fileName))
+        G4cout << "[Response] table loaded from " << fileName << G4endl;
+    else
+        G4cout << "[Response] failed to read " << fileName << G4endl;
+}
@@ -0,0 +1,301 @@
+#include "ResultCache.hh"
+#include "RunAction.hh"
+#include "ResourceUsage.hh"
+
+#include "G4GenericMessenger.hh"
+#include "G4RunManager.hh"
+#include "G4UImanager.hh"
+#include "G4TransportationManager.hh"
+#include "G4Navigator.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VSolid.hh"
+#include "G4Material.hh"
+#include "G4MaterialPropertiesTable.hh"
+#include "G4OpticalSurface.hh"
+#include "G4SurfaceProperty.hh"
+#include "G4OpticalParameters.hh"
+#include "G4VModularPhysicsList.hh"
+#include "G4VPhysicsConstructor.hh"
+#include "G4RegionStore.hh"
+#include "G4Region.hh"
+#include "G4ProductionCuts.hh"
+#include "G4Run.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+#ifndef VETO_BUILD_ID
+#define VETO_BUILD_ID "unknown"
+#endif
+
+namespace {
+    uint64_t Fnv1a(const std::string& text)
+    {
+        uint64_t h = 14695981039346656037ull;
+        for (unsigned char c : text) { h ^= c; h *= 1099511628211ull; }
+        return h;
+    }
+
+    // 결과에 영향 없는 명령
+    G4bool IgnoredCommand(const G4String& cmd)
+    {
+        static const char* prefixes[] = {"/run/beamOn", "/veto/cache/", "/control/", "/vis/",
+                                         "/gui/", "/run/verbose", "/event/verbose", "/tracking/verbose",
+                                         "/run/printProgress", "/veto/adaptive/run", "/veto/scan/run",
+                                         "/veto/trajectory/"};
+        for (auto p : prefixes)
+            if (cmd.compare(0, std::strlen(p), p) == 0) return true;
+        return false;
+    }
+
+    void DescribeVolume(std::ostream& os, const G4VPhysicalVolume* pv)
+    {
+        auto lv = pv->GetLogicalVolume();
+        const G4ThreeVector t = pv->GetTranslation();
+        os << "PV " << pv->GetName() << " " << pv->GetCopyNo() << " " << t.x() << " " << t.y() << " " << t.z();
+        if (auto r = pv->GetRotation()) os << " R " << r->xx() << " " << r->xy() << " " << r->xz()
+                                           << " " << r->yx() << " " << r->yy() << " " << r->yz()
+                                           << " " << r->zx() << " " << r->zy() << " " << r->zz();
+        os << " LV " << lv->GetName() << " " << lv->GetMaterial()->GetName() << "\n";
+        lv->GetSolid()->StreamInfo(os);
+        for (std::size_t i = 0; i < lv->GetNoDaughters(); i++) DescribeVolume(os, lv->GetDaughter(i));
+    }
+
+    void DescribeMPT(std::ostream& os, const G4MaterialPropertiesTable* mpt)
+    {
+        if (!mpt) return;
+        const auto names = mpt->GetMaterialPropertyNames();
+        for (std::size_t i = 0; i < names.size(); i++) {
+            auto v = mpt->GetProperty(G4int(i));
+            if (!v) continue;
+            os << names[i];
+            for (std::size_t k = 0; k < v->GetVectorLength(); k++) os << " " << v->Energy(k) << ":" << (*v)[k];
+            os << "\n";
+        }
+        const auto constNames = mpt->GetMaterialConstPropertyNames();
+        for (std::size_t i = 0; i < constNames.size(); i++)
+            if (mpt->ConstPropertyExists(G4int(i)))
+                os << constNames[i] << " " << mpt->GetConstProperty(G4int(i)) << "\n";
+    }
+
+    // 실행 파일 수정 시각: 다시 빌드하면 (설정 전 git 상태가 같아도) 키가 바뀜
+    long long BinaryTime()
+    {
+        std::error_code ec;
+        const auto t = fs::last_write_time("/proc/self/exe", ec);
+        return ec ? 0 : (long long)t.time_since_epoch().count();
+    }
+}
+
+ResultCache::ResultCache()
+{
+    // 설정 해시에 전체 명령 이력이 필요 (기본 20 개)
+    G4UImanager::GetUIpointer()->SetMaxHistSize(1000000);
+    DefineCommands();
+}
+
+ResultCache::~ResultCache()
+{
+    delete fMessenger;
+}
+
+void ResultCache::DefineCommands()
+{
+    fMessenger = new G4GenericMessenger(this, "/veto/cache/", "Configuration-hashed result cache");
+    fMessenger->DeclareProperty("dir", fDirectory, "Cache directory").SetToBeBroadcasted(false);
+    fMessenger->DeclareProperty("maxSizeMB", fMaxSizeMB, "Cache size limit (least recently used evicted)")
+        .SetToBeBroadcasted(false);
+    fMessenger->DeclareMethod("beamOn", &ResultCache::BeamOn,
+                              "Run n events, or restore the cached output of an identical run")
+        .SetToBeBroadcasted(false);
+    fMessenger->DeclareMethod("stats", &ResultCache::PrintStats, "Print cache statistics")
+        .SetToBeBroadcasted(false);
+}
+
+// ----------------------------------------------------------------------
+// 설정 직렬화
+// ----------------------------------------------------------------------
+void ResultCache::DescribeGeometry(std::ostream& os)
+{
+    auto world = G4TransportationManager::GetTransportationManager()
+                     ->GetNavigatorForTracking()->GetWorldVolume();
+    if (world) DescribeVolume(os, world);
+}
+
+void ResultCache::DescribeOptics(std::ostream& os)
+{
+    for (auto material : *G4Material::GetMaterialTable()) {
+        os << "MAT " << material->GetName() << " " << material->GetDensity() << "\n";
+        DescribeMPT(os, material->GetMaterialPropertiesTable());
+    }
+    for (auto property : *G4SurfaceProperty::GetSurfacePropertyTable()) {
+        auto surface = dynamic_cast<G4OpticalSurface*>(property);
+        if (!surface) continue;
+        os << "SURF " << surface->GetName() << " " << surface->GetModel() << " " << surface->GetFinish()
+           << " " << surface->GetType() << " " << surface->GetSigmaAlpha() << " " << surface->GetPolish() << "\n";
+        DescribeMPT(os, surface->GetMaterialPropertiesTable());
+    }
+    G4OpticalParameters::Instance()->StreamInfo(os);
+}
+
+void ResultCache::DescribePhysics(std::ostream& os)
+{
+    auto list = dynamic_cast<const G4VModularPhysicsList*>(
+        G4RunManager::GetRunManager()->GetUserPhysicsList());
+    if (list)
+        for (G4int i = 0; list->GetPhysics(i); i++) os << "PHYS " << list->GetPhysics(i)->GetPhysicsName() << "\n";
+    for (auto region : *G4RegionStore::GetInstance()) {
+        os << "REGION " << region->GetName();
+        if (auto cuts = region->GetProductionCuts())
+            for (G4int i = 0; i < 4; i++) os << " " << cuts->GetProductionCut(i);
+        os << (region->GetUserLimits() ? " limits" : "") << "\n";
+    }
+}
+
+void ResultCache::DescribeCommands(std::ostream& os)
+{
+    auto ui = G4UImanager::GetUIpointer();
+    for (G4int i = 0; i < ui->GetNumberOfHistory(); i++) {
+        G4String cmd = ui->GetPreviousCommand(i);
+        if (!IgnoredCommand(cmd)) os << "CMD " << cmd << "\n";
+    }
+}
+
+G4String ResultCache::ComputeKey(G4int nEvents)
+{
+    std::ostringstream os;
+    os << std::setprecision(17);
+    DescribeGeometry(os);
+    DescribeOptics(os);
+    DescribePhysics(os);
+    DescribeCommands(os);
+    os << "RNG ";
+    G4Random::getTheEngine()->put(os);
+    os << "\nEVENTS " << nEvents << "\n";
+    os << "BUILD " << VETO_BUILD_ID << " " << BinaryTime() << "\n";
+
+    std::ostringstream key;
+    key << std::hex << std::setw(16) << std::setfill('0') << Fnv1a(os.str());
+    return key.str();
+}
+
+// ----------------------------------------------------------------------
+// 캐시 실행
+// ----------------------------------------------------------------------
+void ResultCache::BeamOn(G4int nEvents)
+{
+    auto runManager = G4RunManager::GetRunManager();
+    auto runAction = dynamic_cast<const RunAction*>(runManager->GetUserRunAction());
+    auto world = G4TransportationManager::GetTransportationManager()
+                     ->GetNavigatorForTracking()->GetWorldVolume();
+    if (!runAction || !world || runAction->UsesRunDirectories()) {
+        G4cout << "[Cache] needs /run/initialize and a single-run output file; running uncached." << G4endl;
+        runManager->BeamOn(nEvents);
+        return;
+    }
+
+    const G4String key = ComputeKey(nEvents);
+    const fs::path dir(fDirectory);
+    const fs::path entry = dir / (key + ".root");
+    const fs::path meta  = dir / (key + ".meta");
+    const fs::path rng   = dir / (key + ".rng");
+    const fs::path output(runAction->GetFileName());
+    std::error_code ec;
+
+    // 난수 상태가 없는 항목은 이후 런을 재현할 수 없으므로 실패로 취급
+    if (fs::exists(entry, ec) && fs::exists(rng, ec)) {
+        fs::copy_file(entry, output, fs::copy_options::overwrite_existing, ec);
+        std::ifstream rngIn(rng);
+        if (!ec && rngIn) {
+            // 런을 돌린 것처럼: 마스터 난수 엔진을 런 뒤 상태로, run ID 하나 증가
+            G4Random::getTheEngine()->get(rngIn);
+            const G4Run* last = runManager->GetCurrentRun();
+            const G4int runID = std::max(fNextRunID, last ? last->GetRunID() + 1 : 0);
+            fNextRunID = runID + 1;
+            runManager->SetRunIDCounter(fNextRunID);
+
+            fs::last_write_time(entry, fs::file_time_type::clock::now(), ec); // LRU 갱신
+            G4double cpu = 0.;
+            std::ifstream(meta) >> cpu;
+            fHits++;
+            fCpuSaved += cpu;
+            G4cout << "[Cache] hit " << key << " -> " << output.string() << " (run " << runID
+                   << ", skipped " << nEvents << " events, " << cpu << " s CPU)" << G4endl;
+            return;
+        }
+        G4cout << "[Cache] cannot restore " << entry.string() << ": " << ec.message() << G4endl;
+    }
+
+    fMisses++;
+    const G4double cpuStart = ResourceUsage::ProcessCpuSeconds();
+    runManager->BeamOn(nEvents);
+    const G4double cpu = ResourceUsage::ProcessCpuSeconds() - cpuStart;
+    fNextRunID = -1;
+
+    fs::create_directories(dir, ec);
+    fs::copy_file(output, entry, fs::copy_options::overwrite_existing, ec);
+    if (ec) {
+        G4cout << "[Cache] cannot store " << entry.string() << ": " << ec.message() << G4endl;
+        return;
+    }
+    std::ofstream(meta) << cpu << "\n";
+    std::ofstream rngOut(rng);
+    G4Random::getTheEngine()->put(rngOut);
+    fStores++;
+    G4cout << "[Cache] miss " << key << " stored (" << cpu << " s CPU)" << G4endl;
+    Evict();
+}
+
+void ResultCache::Evict()
+{
+    struct Entry { fs::path path; fs::file_time_type time; uintmax_t size; };
+    std::vector<Entry> entries;
+    uintmax_t total = 0;
+    std::error_code ec;
+    for (const auto& f : fs::directory_iterator(fDirectory, ec)) {
+        if (f.path().extension() != ".root") continue;
+        entries.push_back({f.path(), fs::last_write_time(f.path(), ec), fs::file_size(f.path(), ec)});
+        total += entries.back().size;
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.time < b.time; });
+
+    const uintmax_t limit = uintmax_t(fMaxSizeMB * 1024. * 1024.);
+    // 가장 최근 항목 (방금 저장/적중) 은 남김
+    for (std::size_t i = 0; i + 1 < entries.size() && total > limit; i++) {
+        const auto& e = entries[i];
+        fs::remove(e.path, ec);
+        fs::path meta = e.path;
+        fs::remove(meta.replace_extension(".meta"), ec);
+        fs::remove(meta.replace_extension(".rng"), ec);
+        total -= e.size;
+        fEvictions++;
+        G4cout << "[Cache] evicted " << e.path.filename().string() << G4endl;
+    }
+}
+
+void ResultCache::PrintStats()
+{
+    uintmax_t bytes = 0;
+    G4int n = 0;
+    std::error_code ec;
+    for (const auto& f : fs::directory_iterator(fDirectory, ec)) {
+        if (f.path().extension() != ".root") continue;
+        bytes += fs::file_size(f.path(), ec);
+        n++;
+    }
+    const G4int lookups = fHits + fMisses;
+    G4cout << "[Cache] " << fDirectory << ": " << n << " entries, " << bytes/(1024.*1024.) << " / "
+           << fMaxSizeMB << " MB | hits " << fHits << ", misses " << fMisses << " (hit rate "
+           << (lookups > 0 ? 100.*fHits/lookups : 0.) << " %) | stored " << fStores
+           << ", evicted " << fEvictions << " | CPU saved " << fCpuSaved << " s" << G4endl;
+}
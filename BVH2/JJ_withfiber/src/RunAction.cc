@@ -3,9 +3,43 @@
 #include "G4UnitsTable.hh"
 #include "G4AccumulableManager.hh"
 #include "G4AnalysisManager.hh"
+#include "PhotonBatchEngine.hh"
+#include "YieldScan.hh"
+#include "PhotonTrackInformation.hh"
+#include "G4GenericMessenger.hh"
+#include "G4Timer.hh"
+#include "ResourceUsage.hh"
+#include "ParameterScan.hh"
+#include "PhaseSpace.hh"
+#include "EventLibrary.hh"
+#include "BeamScan.hh"
+#include "ResponseTableBuilder.hh"
+#include "EfficiencyMode.hh"
+#include "G4AutoLock.hh"
+#include "G4Threading.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Track.hh"
+#include "G4DynamicParticle.hh"
+#include "G4StackedTrack.hh"
+#include "OpticalConfig.hh"
+#include "PhysicsList.hh"
 
 #include "TFile.h"
+#include "TDirectory.h"
+#include "TNamed.h"
 #include "TH1F.h"
+#include "TH2F.h"
+#include "TString.h"
+#include "TTree.h"
+
+#include <algorithm>
+#include <cmath>
+
+RunAction* RunAction::fMasterInstance = nullptr;
+
+namespace {
+    G4Mutex histogramMergeMutex = G4MUTEX_INITIALIZER;
+}
 
 RunAction::RunAction()
     : G4UserRunAction(),
@@ -13,32 +47,136 @@ RunAction::RunAction()
       fTotalEnergyDeposit(0.0),
       rootFile(nullptr),
       hNpe(nullptr),
-      hWavelength(nullptr)
+      hWavelength(nullptr),
+      hNpeBatched(nullptr),
+      fTotalBatchedCount(0),
+      fBatchedPhotons(0.),
+      fBatchedTruncated(0.),
+      fOpticalSteps(0.),
+      fOpticalTracks(0.),
+      fPrimaryRateSum(0.),
+      fDetectedRateSum(0.),
+      fStackDepthSum(0.),
+      fStackDepthMax(0, G4MergeMode::kMaximum),
+      fNOverThreshold(0),
+      fEventCpu(0.),
+      fCpuAfterThreshold(0.),
+      fBeamScanSums("beamScan"),
+      fResponseSums("response")
 {
+    if (IsMaster()) fMasterInstance = this;
    auto accumulableManager = G4AccumulableManager::Instance();
 accumulableManager->Register(fTotalPhotonCount);
 accumulableManager->Register(fTotalEnergyDeposit);
+accumulableManager->Register(fTotalBatchedCount);
+accumulableManager->Register(fBatchedPhotons);
+accumulableManager->Register(fBatchedTruncated);
+accumulableManager->Register(fOpticalSteps);
+accumulableManager->Register(fOpticalTracks);
+accumulableManager->Register(fPrimaryRateSum);
+accumulableManager->Register(fDetectedRateSum);
+accumulableManager->Register(fStackDepthSum);
+accumulableManager->Register(fStackDepthMax);
+accumulableManager->Register(fNOverThreshold);
+accumulableManager->Register(fEventCpu);
+accumulableManager->Register(fCpuAfterThreshold);
+accumulableManager->Register(&fChannelSums);
+accumulableManager->Register(&fBeamScanSums);
+accumulableManager->Register(&fResponseSums);
 
+    fMessenger = new G4GenericMessenger(this, "/veto/output/", "Output control");
+    fMessenger->DeclareProperty("photonPaths", fRecordPhotonPaths,
+                                "Store per-photon optical depths and teflon reflections for reweighting");
+    fMessenger->DeclareProperty("file", fFileName, "ROOT output file");
+    fMessenger->DeclareMethod("runDirectories", &RunAction::SetRunDirectories,
+                              "Keep every run in a run<ID> directory of one output file");
+    fRunTimer = new G4Timer();
 }
 
-RunAction::~RunAction() {}
+RunAction::~RunAction() {
+    if (fMasterInstance == this) fMasterInstance = nullptr;
+    delete fMessenger;
+    delete fRunTimer;
+}
+
+void RunAction::SetRunDirectories(G4bool on) {
+    fRunDirectories = on;
+    fFileCreated = false;
+}
 
-void RunAction::BeginOfRunAction(const G4Run*) {
+void RunAction::BeginOfRunAction(const G4Run* run) {
     auto accumulableManager = G4AccumulableManager::Instance();
     accumulableManager->Reset();
+    PhysicsList::ApplyFastSimulationSwitches();
 
-    // ROOT 파일과 히스토그램 생성
-    rootFile = new TFile("../Histogram/sipm_output.root", "RECREATE");
+    // ROOT 파일과 히스토그램 생성 (runDirectories: 첫 런만 RECREATE, 이후 UPDATE)
+    //  작업 스레드는 파일 없이 히스토그램만 (마스터에 병합)
+    rootFile = IsMaster() ? new TFile(fFileName, (fRunDirectories && fFileCreated) ? "UPDATE" : "RECREATE")
+                          : nullptr;
+    fRunDirectory = nullptr;
+    if (rootFile && fRunDirectories) {
+        fFileCreated = true;
+        fRunDirectory = rootFile->mkdir(Form("run%d", run->GetRunID()));
+        fRunDirectory->cd();
+    }
     hNpe = new TH1F("hNpe", "Number of photoelectrons per event", 80, 0, 80);
     hWavelength = new TH1F("hWavelength", "Detected photon wavelength;Wavelength (nm);Counts", 120, 300, 900);
+    hNpeBatched = nullptr;
+    if (PhotonBatchEngine::GetMode() == PhotonBatchEngine::kValidate)
+        hNpeBatched = new TH1F("hNpeBatched", "Number of photoelectrons per event (batched engine)", 80, 0, 80);
+    hOverThreshold = nullptr;
+    if (EfficiencyMode::IsActive())
+        hOverThreshold = new TH1F("hOverThreshold",
+                                  Form("Event over threshold (npe >= %d);flag;events", EfficiencyMode::GetThreshold()),
+                                  2, 0, 2);
+    tPhotonPaths = nullptr;
+    if (fRecordPhotonPaths && G4Threading::IsMultithreadedApplication()) {
+        if (IsMaster()) G4cout << "[Output] photonPaths is sequential-only; not recorded." << G4endl;
+    } else if (fRecordPhotonPaths) {
+        static const char* tauNames[PhotonTrackInformation::kNMedia] =
+            {"tauScint", "tauCore", "tauClad", "tauGlue"};
+        tPhotonPaths = new TTree("photonPaths", "Detected photon optical history per event");
+        tPhotonPaths->Branch("npe", &fPathNpe);
+        for (G4int m = 0; m < PhotonTrackInformation::kNMedia; m++)
+            tPhotonPaths->Branch(tauNames[m], &fPathTau[m]);
+        tPhotonPaths->Branch("nRefl", &fPathNRefl);
+    }
+    hNpeScan.clear();
+    for (auto yield : YieldScan::GetYields()) {
+        G4int y = G4int(yield*MeV + 0.5);
+        hNpeScan.push_back(new TH1F(Form("hNpe_Y%d", y),
+                                    Form("Number of photoelectrons per event (yield %d/MeV)", y), 80, 0, 80));
+    }
 
     G4cout << "Run started, accumulables reset." << G4endl;
+    fCpuAtRunStart = ResourceUsage::ProcessCpuSeconds();
+    fRssAtRunStart = ResourceUsage::ResidentMemoryMB();
+    fRunTimer->Start();
 }
 
 void RunAction::EndOfRunAction(const G4Run* run) {
     auto accumulableManager = G4AccumulableManager::Instance();
     accumulableManager->Merge();
 
+    fRunTimer->Stop();
+
+    // 작업 스레드: 히스토그램을 마스터에 더하고 끝 (요약/파일은 마스터가)
+    if (!IsMaster()) {
+        auto mine = Histograms();
+        G4AutoLock lock(&histogramMergeMutex);
+        auto master = fMasterInstance ? fMasterInstance->Histograms() : std::vector<TH1F*>();
+        for (std::size_t i = 0; i < mine.size() && i < master.size(); i++) master[i]->Add(mine[i]);
+        lock.unlock();
+        for (auto h : mine) delete h;
+        hNpe = hWavelength = hNpeBatched = hOverThreshold = nullptr;
+        hNpeScan.clear();
+        return;
+    }
+
+    PhaseSpace::EndOfRun();
+    EventLibrary::EndOfRun();
+    if (ResponseTableBuilder::IsCollecting())
+        ResponseTableBuilder::EndOfRun(fResponseSums.GetNpe(), fResponseSums.GetTimes());
     G4int numEvents = run->GetNumberOfEvent();
     if (numEvents == 0) return;
 
@@ -48,18 +186,107 @@ void RunAction::EndOfRunAction(const G4Run* run) {
            << fTotalPhotonCount.GetValue() / static_cast<G4double>(numEvents) << G4endl;
     G4cout << "Average energy deposition per event: "
            << G4BestUnit(fTotalEnergyDeposit.GetValue() / numEvents, "Energy") << G4endl;
+    if (hNpe) {
+        G4cout << "Mean npe (hNpe): " << hNpe->GetMean() << " +- " << hNpe->GetMeanError() << G4endl;
+    }
+    if (fOpticalTracks.GetValue() > 0) {
+        G4cout << "Optical steps per photon: " << fOpticalSteps.GetValue() / fOpticalTracks.GetValue()
+               << " (" << fOpticalSteps.GetValue() / numEvents << " per event)" << G4endl;
+    }
+    G4cout << "CPU time per event: " << fRunTimer->GetUserElapsed()*1000./numEvents << " ms"
+           << " (real " << fRunTimer->GetRealElapsed()*1000./numEvents << " ms)" << G4endl;
+    G4cout << "[Resources] CPU before run " << fCpuAtRunStart << " s | RSS at run start "
+           << fRssAtRunStart << " MB, end " << ResourceUsage::ResidentMemoryMB() << " MB | "
+           << numEvents / std::max(fRunTimer->GetRealElapsed(), 1e-9) << " events/s" << G4endl;
+    {
+        // 스택 트랙 하나 ≈ G4Track + G4DynamicParticle + 스택 항목
+        const G4double kBPerTrack = (sizeof(G4Track) + sizeof(G4DynamicParticle) + sizeof(G4StackedTrack)) / 1024.;
+        const G4double meanDepth = fStackDepthSum.GetValue() / numEvents;
+        const G4int maxDepth = fStackDepthMax.GetValue();
+        G4cout << "[Stack] peak depth per event: mean " << meanDepth << ", max " << maxDepth
+               << " tracks | memory ~" << meanDepth*kBPerTrack << " kB mean, "
+               << maxDepth*kBPerTrack/1024. << " MB max per thread";
+        if (OpticalConfig::PhotonsStaged()) G4cout << " (staged, batch " << OpticalConfig::GetPhotonBatchLimit() << ")";
+        G4cout << G4endl;
+    }
+    if (fPrimaryRateSum.GetValue() > 0.) {
+        G4double rate = fPrimaryRateSum.GetValue() / numEvents;
+        G4cout << "[Cosmic] muon rate through the array " << rate*s << " Hz, detected (npe>0) "
+               << fDetectedRateSum.GetValue() / numEvents * s << " Hz | equivalent exposure "
+               << numEvents / rate / s << " s" << G4endl;
+    }
+    if (!fChannelSums.GetChannels().empty()) {
+        G4cout << "Fired channels: " << fChannelSums.GetChannels().size() << G4endl;
+    }
+    if (EfficiencyMode::IsActive()) {
+        const G4int nOver = fNOverThreshold.GetValue();
+        const G4double eff = G4double(nOver) / numEvents;
+        const G4double after = fCpuAfterThreshold.GetValue() * 1000. / numEvents;
+        G4cout << "[Efficiency] npe >= " << EfficiencyMode::GetThreshold() << ": " << nOver << " / "
+               << numEvents << " = " << eff << " +- " << std::sqrt(eff*(1. - eff)/numEvents)
+               << " | CPU per event " << fEventCpu.GetValue() * 1000. / numEvents << " ms" << G4endl;
+        if (EfficiencyMode::GetMode() == EfficiencyMode::kValidate)
+            G4cout << "[Efficiency] validate: CPU after threshold " << after
+                   << " ms per event (saved by mode on)" << G4endl;
+        else
+            G4cout << "[Efficiency] photons aborted in " << nOver << " events; CPU after threshold "
+                   << after << " ms per event (charged tracks only)" << G4endl;
+    }
+    if (PhotonBatchEngine::GetMode() == PhotonBatchEngine::kValidate) {
+        G4cout << "Average number of photons per event (batched engine): "
+               << fTotalBatchedCount.GetValue() / static_cast<G4double>(numEvents) << G4endl;
+        if (hNpe && hNpeBatched) {
+            const G4double d = hNpeBatched->GetMean() - hNpe->GetMean();
+            const G4double sigma = std::hypot(hNpe->GetMeanError(), hNpeBatched->GetMeanError());
+            G4cout << "[PhotonEngine] validate: npe Geant4 " << hNpe->GetMean() << " +- " << hNpe->GetMeanError()
+                   << ", engine " << hNpeBatched->GetMean() << " +- " << hNpeBatched->GetMeanError()
+                   << " (" << (sigma > 0. ? d/sigma : 0.) << " sigma)" << G4endl;
+        }
+    }
+    if (PhotonBatchEngine::CollectsGensteps() && fBatchedPhotons.GetValue() > 0.) {
+        G4cout << "[PhotonEngine] " << fBatchedPhotons.GetValue() << " photons propagated, "
+               << fBatchedTruncated.GetValue() << " killed at the interaction limit ("
+               << fBatchedTruncated.GetValue() / fBatchedPhotons.GetValue() << ")" << G4endl;
+    }
 
     // ROOT 파일 저장
     if (rootFile) {
-        rootFile->cd();
+        if (fRunDirectory) {
+            fRunDirectory->cd();
+            if (!ParameterScan::GetPointLabel().empty())
+                TNamed("parameters", ParameterScan::GetPointLabel().c_str()).Write();
+        } else {
+            rootFile->cd();
+        }
         if (hNpe) hNpe->Write();
         if (hWavelength) hWavelength->Write();
+        if (hNpeBatched) hNpeBatched->Write();
+        if (hOverThreshold) hOverThreshold->Write();
+        for (auto h : hNpeScan) h->Write();
+        if (tPhotonPaths) tPhotonPaths->Write();
+        WriteChannels();
+        WriteBeamScan();
         rootFile->Close();
         delete rootFile;
         rootFile = nullptr;
+        fRunDirectory = nullptr;
+        // TH1::AddDirectory(false) (멀티스레드) 면 파일이 소유하지 않음
+        if (!TH1::AddDirectoryStatus()) {
+            for (auto h : Histograms()) delete h;
+            hNpe = hWavelength = hNpeBatched = hOverThreshold = nullptr;
+            hNpeScan.clear();
+        }
     }
 }
 
+std::vector<TH1F*> RunAction::Histograms() const {
+    std::vector<TH1F*> list;
+    for (auto h : {hNpe, hWavelength, hNpeBatched, hOverThreshold})
+        if (h) list.push_back(h);
+    list.insert(list.end(), hNpeScan.begin(), hNpeScan.end());
+    return list;
+}
+
 void RunAction::AddPhotonCount(G4int count) {
     fTotalPhotonCount += count;
 }
@@ -68,6 +295,28 @@ void RunAction::AddEnergyDeposit(G4double energy) {
     fTotalEnergyDeposit += energy;
 }
 
+void RunAction::AddOpticalSteps(G4int steps, G4int tracks) {
+    fOpticalSteps += steps;
+    fOpticalTracks += tracks;
+}
+
+void RunAction::AddStackDepth(G4int peak) {
+    fStackDepthSum += peak;
+    if (peak > fStackDepthMax.GetValue()) fStackDepthMax = peak;
+}
+
+void RunAction::AddEfficiencyEvent(G4bool overThreshold, G4double cpu, G4double cpuAfterThreshold) {
+    if (overThreshold) fNOverThreshold += 1;
+    fEventCpu += cpu;
+    fCpuAfterThreshold += cpuAfterThreshold;
+    if (hOverThreshold) hOverThreshold->Fill(overThreshold ? 1 : 0);
+}
+
+void RunAction::AddPrimaryRate(G4double rate, G4bool detected) {
+    fPrimaryRateSum += rate;
+    if (detected) fDetectedRateSum += rate;
+}
+
 // ---- 새로 추가된 함수 ----
 void RunAction::FillWavelengths(const std::vector<G4double>& wavelengths) {
     if (!hWavelength) return;
@@ -79,3 +328,160 @@ void RunAction::FillWavelengths(const std::vector<G4double>& wavelengths) {
 void RunAction::FillNpe(G4int npe) {
     if (hNpe) hNpe->Fill(npe);
 }
+
+void RunAction::FillNpeBatched(G4int npe) {
+    fTotalBatchedCount += npe;
+    if (hNpeBatched) hNpeBatched->Fill(npe);
+}
+
+void RunAction::AddBatchedPhotons(G4int propagated, G4int truncated) {
+    fBatchedPhotons += propagated;
+    fBatchedTruncated += truncated;
+}
+
+void RunAction::FillNpeScan(const std::vector<G4int>& npe) {
+    for (std::size_t i = 0; i < npe.size() && i < hNpeScan.size(); i++)
+        hNpeScan[i]->Fill(npe[i]);
+}
+
+void RunAction::FillPhotonPaths(G4int npe, const std::vector<PhotonTrackInformation>& paths) {
+    if (!tPhotonPaths) return;
+    fPathNpe = npe;
+    for (G4int m = 0; m < PhotonTrackInformation::kNMedia; m++) {
+        fPathTau[m].clear();
+        for (const auto& p : paths) fPathTau[m].push_back(p.GetOpticalDepth(m));
+    }
+    fPathNRefl.clear();
+    for (const auto& p : paths) fPathNRefl.push_back(p.GetNReflections());
+    tPhotonPaths->Fill();
+}
+
+void RunAction::FillChannel(G4int channel, G4int npe, G4double firstTime,
+                            G4double wlSum, G4double wlSum2, G4int wlN) {
+    fChannelSums.Fill(channel, npe, firstTime, wlSum, wlSum2, wlN);
+}
+
+// ----------------------------------------------------------------------
+// 채널별 출력: channels/ 아래 hNpe_ch<N>, hTime_ch<N> + 요약 트리
+//  (현재 디렉토리 = 런 디렉토리 또는 파일 최상위)
+// ----------------------------------------------------------------------
+void RunAction::WriteChannels() {
+    const auto& channels = fChannelSums.GetChannels();
+    if (channels.empty()) return;
+
+    TDirectory* parent = gDirectory;
+    TDirectory* dir = parent->mkdir("channels");
+    dir->cd();
+
+    Int_t ch = 0, nFired = 0;
+    Double_t meanNpe = 0., meanWl = 0., rmsWl = 0.;
+    TTree summary("channelSummary", "Per-channel run summary");
+    summary.Branch("channel", &ch);
+    summary.Branch("nFired", &nFired);
+    summary.Branch("meanNpe", &meanNpe);
+    summary.Branch("meanWavelength", &meanWl);
+    summary.Branch("rmsWavelength", &rmsWl);
+
+    const G4double tMax = ChannelAccumulable::kTimeMax / ns;
+    for (const auto& entry : channels) {
+        const auto& s = entry.second;
+        TH1F hN(Form("hNpe_ch%d", entry.first),
+                Form("Number of photoelectrons per fired event (channel %d)", entry.first),
+                ChannelAccumulable::kNpeBins, 0, ChannelAccumulable::kNpeBins);
+        TH1F hT(Form("hTime_ch%d", entry.first),
+                Form("First detection time (channel %d);Time (ns);Events", entry.first),
+                ChannelAccumulable::kTimeBins, 0, tMax);
+        for (G4int b = 0; b <= ChannelAccumulable::kNpeBins; b++)
+            hN.SetBinContent(b + 1, s.npeCounts[b]);    // 마지막 = ROOT overflow bin
+        for (G4int b = 0; b <= ChannelAccumulable::kTimeBins; b++)
+            hT.SetBinContent(b + 1, s.timeCounts[b]);
+        hN.SetEntries(s.nFired);
+        hT.SetEntries(s.nFired);
+        hN.Write();
+        hT.Write();
+
+        ch = entry.first;
+        nFired = s.nFired;
+        meanNpe = s.nFired > 0 ? s.npeSum / s.nFired : 0.;
+        meanWl = s.wlN > 0 ? s.wlSum / s.wlN : 0.;
+        rmsWl = s.wlN > 0 ? std::sqrt(std::max(s.wlSum2/s.wlN - meanWl*meanWl, 0.)) : 0.;
+        summary.Fill();
+    }
+    summary.Write();
+    parent->cd();
+}
+
+void RunAction::FillBeamScan(G4int point, G4int npe, G4double firstTime) {
+    fBeamScanSums.Fill(point, npe, firstTime, 0., 0., 0);
+}
+
+void RunAction::FillResponse(G4int npe, const std::vector<G4double>& hitTimes) {
+    fResponseSums.Fill(npe, hitTimes);
+}
+
+// ----------------------------------------------------------------------
+// 빔 스캔 출력: beamScan/ 아래 θ 마다 (y, z) 맵 3 개
+//  hMeanNpe_th<k>, hRmsNpe_th<k>, hEff_th<k> (효율 = npe >= threshold 비율)
+//  bin 경계 = 이웃 격자점의 중점 (격자 간격이 고르지 않아도 됨)
+// ----------------------------------------------------------------------
+void RunAction::WriteBeamScan() {
+    const auto& points = fBeamScanSums.GetChannels();
+    if (points.empty()) return;
+
+    auto Edges = [](const std::vector<G4double>& c) {
+        const std::size_t n = c.size();
+        const G4double d0 = n > 1 ? c[1] - c[0] : 2.*mm;
+        const G4double d1 = n > 1 ? c[n-1] - c[n-2] : 2.*mm;
+        std::vector<Double_t> e(n + 1);
+        e.front() = (c.front() - 0.5*d0) / mm;
+        for (std::size_t i = 1; i < n; i++) e[i] = 0.5*(c[i-1] + c[i]) / mm;
+        e.back() = (c.back() + 0.5*d1) / mm;
+        return e;
+    };
+    const auto& ys = BeamScan::GetYs();
+    const auto& zs = BeamScan::GetZs();
+    const auto& thetas = BeamScan::GetThetas();
+    const auto yEdges = Edges(ys), zEdges = Edges(zs);
+    const G4int nY = ys.size(), nZ = zs.size();
+    const G4int threshold = std::max(BeamScan::GetThreshold(), 0);
+
+    TDirectory* parent = gDirectory;
+    TDirectory* dir = parent->mkdir("beamScan");
+    dir->cd();
+    G4double effSum = 0.;
+    for (std::size_t k = 0; k < thetas.size(); k++) {
+        G4double th = thetas[k]/deg;
+        TH2F hMean(Form("hMeanNpe_th%zu", k), Form("Mean npe (#theta = %g deg);y (mm);z (mm)", th),
+                   nY, yEdges.data(), nZ, zEdges.data());
+        TH2F hRms(Form("hRmsNpe_th%zu", k), Form("npe RMS (#theta = %g deg);y (mm);z (mm)", th),
+                  nY, yEdges.data(), nZ, zEdges.data());
+        TH2F hEff(Form("hEff_th%zu", k),
+                  Form("Efficiency npe >= %d (#theta = %g deg);y (mm);z (mm)", threshold, th),
+                  nY, yEdges.data(), nZ, zEdges.data());
+        for (G4int iZ = 0; iZ < nZ; iZ++)
+        for (G4int iY = 0; iY < nY; iY++) {
+            auto it = points.find((G4int(k)*nZ + iZ)*nY + iY);
+            if (it == points.end() || it->second.nFired == 0) continue;
+            const auto& s = it->second;
+            G4double n = s.nFired;
+            G4double mean = s.npeSum / n;
+            G4double rms = std::sqrt(std::max(s.npeSum2/n - mean*mean, 0.));
+            G4int above = 0;
+            for (G4int b = std::min(threshold, G4int(ChannelAccumulable::kNpeBins));
+                 b <= ChannelAccumulable::kNpeBins; b++) above += s.npeCounts[b];
+            G4double eff = above / n;
+            hMean.SetBinContent(iY + 1, iZ + 1, mean);
+            hMean.SetBinError(iY + 1, iZ + 1, rms / std::sqrt(n));
+            hRms.SetBinContent(iY + 1, iZ + 1, rms);
+            hEff.SetBinContent(iY + 1, iZ + 1, eff);
+            hEff.SetBinError(iY + 1, iZ + 1, std::sqrt(eff*(1. - eff) / n));
+            effSum += eff;
+        }
+        hMean.Write();
+        hRms.Write();
+        hEff.Write();
+    }
+    parent->cd();
+    G4cout << "[BeamScan] " << points.size() << " points, mean efficiency (npe >= " << threshold
+           << ") " << effSum / points.size() << G4endl;
+}
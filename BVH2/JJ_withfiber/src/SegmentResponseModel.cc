@@ -0,0 +1,117 @@
+#include "SegmentResponseModel.hh"
+#include "ResponseTable.hh"
+#include "EventAction.hh"
+#include "SiPMSensitiveDetector.hh"
+
+#include "G4FastTrack.hh"
+#include "G4FastStep.hh"
+#include "G4EventManager.hh"
+#include "G4MuonMinus.hh"
+#include "G4MuonPlus.hh"
+#include "G4Electron.hh"
+#include "G4Positron.hh"
+#include "G4VSolid.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4AffineTransform.hh"
+#include "G4Material.hh"
+#include "G4SystemOfUnits.hh"
+#include "CLHEP/Units/PhysicalConstants.h"
+
+#include <algorithm>
+#include <cmath>
+
+G4bool SegmentResponseModel::fEnabled = false;
+
+namespace {
+    const G4double kFaceTolerance = 1.0*um;
+}
+
+SegmentResponseModel::SegmentResponseModel(const G4String& name, G4Region* envelope)
+    : G4VFastSimulationModel(name, envelope)
+{}
+
+SegmentResponseModel::~SegmentResponseModel() {}
+
+G4bool SegmentResponseModel::IsApplicable(const G4ParticleDefinition& particle)
+{
+    return &particle == G4MuonMinus::Definition() || &particle == G4MuonPlus::Definition() ||
+           &particle == G4Electron::Definition()  || &particle == G4Positron::Definition();
+}
+
+// ----------------------------------------------------------------------
+// 테이블 격자와 같은 조건에서만 발동: 1차 입자 (테이블은 1차 입자로 생성),
+//  -X 입구면, +X 방향 진입. 2차 e± (δ선 등) 는 Geant4 가 추적
+// ----------------------------------------------------------------------
+G4bool SegmentResponseModel::ModelTrigger(const G4FastTrack& fastTrack)
+{
+    if (!fEnabled || !ResponseTable::Instance()->IsLoaded()) return false;
+    if (fastTrack.GetPrimaryTrack()->GetParentID() != 0) return false;
+
+    G4ThreeVector pMin, pMax;
+    fastTrack.GetEnvelopeSolid()->BoundingLimits(pMin, pMax);
+    const G4ThreeVector pos = fastTrack.GetPrimaryTrackLocalPosition();
+    const G4ThreeVector dir = fastTrack.GetPrimaryTrackLocalDirection();
+    return dir.x() > 0. && std::fabs(pos.x() - pMin.x()) < kFaceTolerance;
+}
+
+void SegmentResponseModel::DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep)
+{
+    auto table = ResponseTable::Instance();
+    auto track = fastTrack.GetPrimaryTrack();
+    const G4ThreeVector pos = fastTrack.GetPrimaryTrackLocalPosition();
+    const G4ThreeVector dir = fastTrack.GetPrimaryTrackLocalDirection();
+    const G4double ekin = track->GetKineticEnergy();
+    const G4double t0   = track->GetGlobalTime();
+
+    const G4bool isMuon = (std::fabs(track->GetDefinition()->GetPDGEncoding()) == 13);
+    G4int cell = table->FindCell(isMuon ? ResponseTable::kMuon : ResponseTable::kBeta,
+                                 ekin, pos.y(), pos.z(), std::atan2(dir.z(), dir.x()));
+
+    // 검출 광전자: SiPM SD 와 같은 방식으로 EventAction 에 기록 (PDE 는 테이블에 포함)
+    auto eventAction = static_cast<EventAction*>(
+        G4EventManager::GetEventManager()->GetUserEventAction());
+    if (eventAction) {
+        G4int channel = SiPMSensitiveDetector::ChannelOf(track->GetTouchable());
+        G4int npe = table->SampleNpe(cell);
+        for (G4int i = 0; i < npe; i++) {
+            G4double t = t0 + table->SampleTime(cell);
+            eventAction->AddPhoton();
+            eventAction->AddHitTime(t);
+            eventAction->AddChannelHit(channel, t, 0.);
+        }
+    }
+
+    if (!isMuon) {
+        // 베타: 세그먼트 안에서 정지
+        fastStep.KillPrimaryTrack();
+        fastStep.ProposeTotalEnergyDeposited(ekin);
+        return;
+    }
+
+    // 뮤온: 신틸 출구까지 직진. bounding box 가 아니라 solid (boolean: groove 를 뺀 형상)
+    //  와 daughter (nested: groove 공기) 까지의 거리 → groove 안으로 옮기지 않음
+    G4double sExit = fastTrack.GetEnvelopeSolid()->DistanceToOut(pos, dir);
+    auto envelopeLV = fastTrack.GetEnvelopeLogicalVolume();
+    for (std::size_t i = 0; i < envelopeLV->GetNoDaughters(); i++) {
+        auto daughter = envelopeLV->GetDaughter(i);
+        G4AffineTransform toDaughter(daughter->GetRotation(), daughter->GetTranslation());
+        toDaughter.Invert();
+        sExit = std::min(sExit, daughter->GetLogicalVolume()->GetSolid()->DistanceToIn(
+                                    toDaughter.TransformPoint(pos), toDaughter.TransformAxis(dir)));
+    }
+    sExit = std::max(sExit, 0.) + kFaceTolerance;
+
+    // 실제 입자/에너지/물질의 전체 dE/dx (컷 없음), 경로 중간 에너지에서 한 번 보정
+    const auto particle = track->GetDefinition();
+    const auto material = track->GetMaterial();
+    G4double dE = std::min(fEmCalculator.ComputeTotalDEDX(ekin, particle, material) * sExit, ekin);
+    dE = std::min(fEmCalculator.ComputeTotalDEDX(ekin - 0.5*dE, particle, material) * sExit, ekin);
+    G4double v  = track->GetVelocity();
+
+    fastStep.ProposePrimaryTrackFinalPosition(pos + sExit*dir);
+    fastStep.ProposePrimaryTrackFinalTime(t0 + sExit/v);
+    fastStep.ProposePrimaryTrackFinalKineticEnergy(ekin - dE);
+    fastStep.ProposePrimaryTrackPathLength(sExit);
+    fastStep.ProposeTotalEnergyDeposited(dE);
+}
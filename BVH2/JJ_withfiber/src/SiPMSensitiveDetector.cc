@@ -1,5 +1,7 @@
 #include "SiPMSensitiveDetector.hh"
 #include "EventAction.hh"
+#include "PhotonTrackInformation.hh"
+#include "EfficiencyMode.hh"
 
 #include "G4SystemOfUnits.hh"
 #include "G4Step.hh"
@@ -25,7 +27,7 @@ namespace {
         4.5,4
     };
 
-    double GetPDE(double wavelength_nm) {
+    double InterpolatePDE(double wavelength_nm) {
         if (wavelength_nm <= pde_wl[0]) return pde_val[0] / 100.0;
         if (wavelength_nm >= pde_wl[Npde-1]) return pde_val[Npde-1] / 100.0;
         for (int i=0; i<Npde-1; i++) {
@@ -58,22 +60,52 @@ G4bool SiPMSensitiveDetector::ProcessHits(G4Step* step, G4TouchableHistory* /*hi
     // photon은 무조건 종료
     track->SetTrackStatus(fStopAndKill);
 
+    auto eventAction = static_cast<EventAction*>(
+        G4EventManager::GetEventManager()->GetUserEventAction());
+    return RecordPhoton(track->GetTotalEnergy(), track->GetGlobalTime(),
+                        static_cast<const PhotonTrackInformation*>(track->GetUserInformation()),
+                        ChannelOf(step->GetPreStepPoint()->GetTouchable()),
+                        eventAction && eventAction->IsScintillationPhoton(track->GetTrackID()));
+}
+
+// SiPM 은 Segment 의 직속 daughter → 보통 depth 1 에서 끝남
+G4int SiPMSensitiveDetector::ChannelOf(const G4VTouchable* touchable) {
+    if (!touchable) return 0;
+    for (G4int depth = 0; depth < touchable->GetHistoryDepth(); depth++) {
+        auto pv = touchable->GetVolume(depth);
+        if (pv && pv->GetName() == "Segment") return touchable->GetReplicaNumber(depth);
+    }
+    return 0;
+}
+
+G4double SiPMSensitiveDetector::GetPDE(G4double wavelength_nm) {
+    return InterpolatePDE(wavelength_nm);
+}
+
+G4bool SiPMSensitiveDetector::RecordPhoton(G4double photonEnergy, G4double time,
+                                           const PhotonTrackInformation* pathInfo,
+                                           G4int channel, G4bool scintOrigin) {
     // EventAction 가져오기
     auto eventAction = static_cast<EventAction*>(
         G4EventManager::GetEventManager()->GetUserEventAction());
     if (!eventAction) return false;
 
     // 파장 계산 (nm)
-    double energy = step->GetTrack()->GetTotalEnergy();
-    double wavelength = (CLHEP::h_Planck * CLHEP::c_light / energy) / nm;
+    double wavelength = (CLHEP::h_Planck * CLHEP::c_light / photonEnergy) / nm;
 
     // PDE 확률
     double pde = GetPDE(wavelength);
     if (G4UniformRand() >= pde) return false; // 검출 실패
 
     // 검출 성공 시 카운트
-    eventAction->AddPhoton();
+    eventAction->AddPhoton(scintOrigin);
    eventAction->AddWavelength(wavelength);
+    eventAction->AddHitTime(time);
+    eventAction->AddChannelHit(channel, time, wavelength);
+    if (pathInfo && eventAction->RecordsPhotonPaths()) eventAction->AddPhotonPath(*pathInfo);
+    if (EfficiencyMode::IsActive() && !eventAction->IsOverThreshold()
+        && eventAction->GetPhotonCount() >= EfficiencyMode::GetThreshold())
+        eventAction->MarkOverThreshold();
 
     // 디버그 출력 (100개마다)
     if (eventAction->GetPhotonCount() % 100 == 0) {
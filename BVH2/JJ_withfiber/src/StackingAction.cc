@@ -0,0 +1,49 @@
+#include "StackingAction.hh"
+#include "OpticalConfig.hh"
+#include "EfficiencyMode.hh"
+#include "EventAction.hh"
+
+#include "G4Track.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4EventManager.hh"
+#include "G4StackManager.hh"
+
+namespace {
+    EventAction* CurrentEventAction()
+    {
+        return static_cast<EventAction*>(G4EventManager::GetEventManager()->GetUserEventAction());
+    }
+
+    G4bool EventOverThreshold()
+    {
+        auto eventAction = CurrentEventAction();
+        return eventAction && eventAction->IsOverThreshold();
+    }
+}
+
+StackingAction::StackingAction() : G4UserStackingAction() {}
+StackingAction::~StackingAction() {}
+
+G4ClassificationOfNewTrack StackingAction::ClassifyNewTrack(const G4Track* track)
+{
+    if (track->GetDefinition() != G4OpticalPhoton::Definition()) {
+        // staged: 한도 때문에 suspend 된 하전 트랙은 대기 광자 뒤로
+        if (OpticalConfig::PhotonsStaged() && track->GetTrackStatus() == fSuspend) {
+            auto eventAction = CurrentEventAction();
+            if (eventAction && eventAction->IsPhotonStageFull()) return fWaiting;
+        }
+        return fUrgent;
+    }
+    if (OpticalConfig::IsKilled(track)) return fKill;
+    if (EfficiencyMode::AbortsPhotons() && EventOverThreshold()) return fKill;
+    return OpticalConfig::PhotonsWaiting() ? fWaiting : fUrgent;
+}
+
+void StackingAction::NewStage()
+{
+    // waiting → urgent 로 옮겨졌으니 staged 한도 해제
+    auto eventAction = CurrentEventAction();
+    if (eventAction) eventAction->SetPhotonStageFull(false);
+    // waiting 스택에서 넘어온 광자도 문턱 이후면 제거
+    if (EfficiencyMode::AbortsPhotons() && EventOverThreshold()) stackManager->ReClassify();
+}
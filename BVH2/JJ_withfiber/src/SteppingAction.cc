@@ -7,6 +7,22 @@
 #include "G4SystemOfUnits.hh"
 #include "G4ios.hh"
 #include "G4VProcess.hh"
+#include "G4Scintillation.hh"
+#include "G4ProcessTable.hh"
+#include "G4Material.hh"
+#include "G4MaterialPropertiesTable.hh"
+#include "G4AffineTransform.hh"
+#include "G4NavigationHistory.hh"
+#include "PhotonBatchEngine.hh"
+#include "PhotonTrackInformation.hh"
+#include "G4OpticalPhoton.hh"
+#include "TabulatedBoundaryProcess.hh"
+#include "G4ProcessManager.hh"
+#include "PhaseSpace.hh"
+#include "OpticalConfig.hh"
+#include "G4SteppingManager.hh"
+#include "G4EventManager.hh"
+#include "G4StackManager.hh"
 
 SteppingAction::SteppingAction(EventAction* eventAction)
     : G4UserSteppingAction(),
@@ -25,6 +41,51 @@ void SteppingAction::UserSteppingAction(const G4Step* step) {
         if (fEventAction && edep > 0.) {
             fEventAction->AddEnergyDeposit(edep);
         }
+
+        // 배치 엔진: 이 스텝에서 G4Scintillation 이 계산한 광자 수를 genstep 으로 저장
+        // (fast-simulation 스텝은 G4Scintillation 이 돌지 않았으므로 제외)
+        auto preMPT = step->GetPreStepPoint()->GetMaterial()->GetMaterialPropertiesTable();
+        auto stepProc = step->GetPostStepPoint()->GetProcessDefinedStep();
+        G4bool fastStep = stepProc && stepProc->GetProcessType() == fParameterisation;
+        if (fEventAction && edep > 0. && !fastStep && PhotonBatchEngine::CollectsGensteps() &&
+            preMPT && preMPT->ConstPropertyExists("SCINTILLATIONYIELD")) {
+            if (!fScintProcess) {
+                fScintProcess = dynamic_cast<G4Scintillation*>(
+                    G4ProcessTable::GetProcessTable()->FindProcess("Scintillation", particleDef));
+            }
+            G4int nPhotons = fScintProcess ? fScintProcess->GetNumPhotons() : 0;
+            if (nPhotons > 0) {
+                auto pre  = step->GetPreStepPoint();
+                auto post = step->GetPostStepPoint();
+                // 신틸 PV 로컬(바) 좌표계로 변환
+                const G4AffineTransform& toLocal =
+                    pre->GetTouchable()->GetHistory()->GetTopTransform();
+                PhotonBatchEngine::Genstep gs;
+                gs.x0 = toLocal.TransformPoint(pre->GetPosition());
+                gs.x1 = toLocal.TransformPoint(post->GetPosition());
+                gs.t0 = pre->GetGlobalTime();
+                gs.t1 = post->GetGlobalTime();
+                gs.nPhotons = nPhotons;
+                gs.segment  = pre->GetTouchable()->GetCopyNumber(1); // 세그먼트 envelope
+                fEventAction->AddGenstep(gs);
+            }
+        }
+    }
+
+    // 스택 깊이: 광자를 만드는 트랙 (광학 광자 외) 스텝마다
+    //  photonStack staged: 스택 전체 (urgent + waiting) + 아직 스택에 안 올라간 2차 입자가
+    //  한도면 suspend. urgent 만 세지 않으면 재개된 트랙이 urgent 에 남은 광자 위에
+    //  waiting 을 다시 한도까지 채워 최대 깊이가 한도의 두 배가 됨
+    if (fEventAction && particleDef != G4OpticalPhoton::Definition()) {
+        auto stack = G4EventManager::GetEventManager()->GetStackManager();
+        const G4int pending = fpSteppingManager->GetfSecondary()->size();
+        fEventAction->UpdateStackDepth(stack->GetNTotalTrack() + pending);
+        const auto status = track->GetTrackStatus();
+        if (OpticalConfig::PhotonsStaged() && pending > 0 && (status == fAlive || status == fSuspend)
+            && stack->GetNTotalTrack() + pending >= OpticalConfig::GetPhotonBatchLimit()) {
+            track->SetTrackStatus(fSuspend);
+            fEventAction->SetPhotonStageFull(true);
+        }
     }
 /*
     // 2. 모든 step에 대해 어떤 process가 불렸는지 출력 (디버깅용)
@@ -45,9 +106,62 @@ void SteppingAction::UserSteppingAction(const G4Step* step) {
                << postPoint->GetPosition() << G4endl;
     }
 */
-    // 4. Optical photon 궤적을 보고 싶으면 주석 해제
+    // Phase-space 기록 (평면 통과 / envelope 진입), 기록 후 추적 종료 선택
+    if (fEventAction && PhaseSpace::IsRecording()) {
+        PhaseSpace::Record rec;
+        if (PhaseSpace::Check(step, rec)) {
+            fEventAction->AddPhaseSpaceRecord(rec);
+            if (PhaseSpace::KillsRecorded()) {
+                track->SetTrackStatus(fStopAndKill);
+                return;
+            }
+        }
+    }
+
+    // 4. Optical photon: 재가중용 경로 기록 (궤적을 보고 싶으면 아래 주석 해제)
     if (particleName == "opticalphoton") {
+        if (fEventAction) fEventAction->AddOpticalStep(track->GetCurrentStepNumber() == 1);
+        if (fEventAction && fEventAction->RecordsPhotonPaths()) RecordPhotonPath(step);
         // G4cout << "Optical photon step at: "
         //        << track->GetPosition() << G4endl;
     }
 }
+
+// ----------------------------------------------------------------------
+// 광자 스텝 → 재질별 광학 깊이, 테플론 Lambertian 반사 횟수
+// ----------------------------------------------------------------------
+void SteppingAction::RecordPhotonPath(const G4Step* step) {
+    auto track = step->GetTrack();
+    auto info = static_cast<PhotonTrackInformation*>(track->GetUserInformation());
+    if (!info) return;
+
+    auto pre = step->GetPreStepPoint();
+    auto material = pre->GetMaterial();
+    if (material != fLastMaterial) {
+        fLastMaterial = material;
+        fLastMedium = PhotonTrackInformation::MediumIndex(material);
+    }
+    if (fLastMedium >= 0) {
+        auto mpt = material->GetMaterialPropertiesTable();
+        auto abs = mpt ? mpt->GetProperty("ABSLENGTH") : nullptr;
+        if (abs) info->AddOpticalDepth(fLastMedium,
+                                       step->GetStepLength() / abs->Value(track->GetTotalEnergy()));
+    }
+
+    if (!fBoundaryProcess) {
+        auto pm = G4OpticalPhoton::OpticalPhotonDefinition()->GetProcessManager();
+        auto procs = pm->GetProcessList();
+        for (std::size_t i = 0; i < procs->size(); i++) {
+            fBoundaryProcess = dynamic_cast<G4OpBoundaryProcess*>((*procs)[i]);
+            if (fBoundaryProcess) break;
+        }
+        if (!fBoundaryProcess) return;
+        fTabulatedBoundary = dynamic_cast<TabulatedBoundaryProcess*>(fBoundaryProcess);
+    }
+    // 이 스텝이 경계에서 끝났을 때만 상태가 유효
+    auto post = step->GetPostStepPoint();
+    const auto status = fTabulatedBoundary ? fTabulatedBoundary->GetLastStatus()
+                                           : fBoundaryProcess->GetStatus();
+    if (post->GetStepStatus() == fGeomBoundary && status == LambertianReflection)
+        info->AddReflection();
+}
@@ -0,0 +1,78 @@
+#include "TabulatedBoundaryProcess.hh"
+#include "WrapReflectanceTable.hh"
+
+#include "G4LogicalBorderSurface.hh"
+#include "G4LogicalSkinSurface.hh"
+#include "G4OpticalSurface.hh"
+#include "G4TransportationManager.hh"
+#include "G4Navigator.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4GeometryTolerance.hh"
+#include "Randomize.hh"
+
+TabulatedBoundaryProcess::TabulatedBoundaryProcess()
+    : G4OpBoundaryProcess("OpBoundary")
+{}
+
+TabulatedBoundaryProcess::~TabulatedBoundaryProcess() {}
+
+const G4OpticalSurface* TabulatedBoundaryProcess::FindSurface(const G4Step& step)
+{
+    auto prePV  = step.GetPreStepPoint()->GetPhysicalVolume();
+    auto postPV = step.GetPostStepPoint()->GetPhysicalVolume();
+    if (!prePV || !postPV) return nullptr;
+
+    G4LogicalSurface* surface = G4LogicalBorderSurface::GetSurface(prePV, postPV);
+    if (!surface) {
+        G4bool entering = (postPV->GetMotherLogical() == prePV->GetLogicalVolume());
+        auto first  = entering ? postPV : prePV;
+        auto second = entering ? prePV  : postPV;
+        surface = G4LogicalSkinSurface::GetSurface(first->GetLogicalVolume());
+        if (!surface) surface = G4LogicalSkinSurface::GetSurface(second->GetLogicalVolume());
+    }
+    return surface ? dynamic_cast<const G4OpticalSurface*>(surface->GetSurfaceProperty()) : nullptr;
+}
+
+G4VParticleChange* TabulatedBoundaryProcess::PostStepDoIt(const G4Track& track, const G4Step& step)
+{
+    fHandled = false;
+    auto table = WrapReflectanceTable::Instance();
+    auto post  = step.GetPostStepPoint();
+    // 표면 탐색은 테이블 대상이 있을 때만; 같은 물질 경계는 G4OpBoundaryProcess 처럼 통과 (SameMaterial)
+    if (!table->IsActive() || post->GetStepStatus() != fGeomBoundary ||
+        track.GetStepLength() <= G4GeometryTolerance::GetInstance()->GetSurfaceTolerance() ||
+        step.GetPreStepPoint()->GetMaterial() == post->GetMaterial() ||
+        !table->Applies(FindSurface(step)))
+        return G4OpBoundaryProcess::PostStepDoIt(track, step);
+
+    // 전역 법선: 앞 볼륨 밖을 향하는 exit normal → 뒤집어 앞 볼륨 안쪽으로
+    G4bool valid = false;
+    G4ThreeVector exitNormal = G4TransportationManager::GetTransportationManager()
+        ->GetNavigatorForTracking()->GetGlobalExitNormal(post->GetPosition(), &valid);
+    if (!valid) return G4OpBoundaryProcess::PostStepDoIt(track, step);
+    const G4ThreeVector oldDir = track.GetMomentumDirection();
+    G4ThreeVector normal = -exitNormal;
+    // 광자는 표면으로 들어가는 방향이어야 함 (G4OpBoundaryProcess 와 같은 보정)
+    if (oldDir*normal > 0.) normal = -normal;
+
+    aParticleChange.Initialize(track);
+    aParticleChange.ProposeVelocity(track.GetVelocity());
+    fHandled = true;
+
+    const G4double energy = track.GetDynamicParticle()->GetTotalMomentum();
+    if (G4UniformRand() >= table->Reflectance(energy)) {
+        fTableStatus = Absorption;
+        aParticleChange.ProposeTrackStatus(fStopAndKill);
+        return &aParticleChange;
+    }
+
+    const G4ThreeVector oldPol = track.GetPolarization();
+    const G4ThreeVector newDir = table->SampleDirection(normal);
+    const G4ThreeVector facet  = (newDir - oldDir).unit();
+
+    fTableStatus = LambertianReflection;
+    aParticleChange.ProposeMomentumDirection(newDir);
+    aParticleChange.ProposePolarization((-oldPol + 2.*(oldPol*facet)*facet).unit());
+    return &aParticleChange;
+}
@@ -0,0 +1,25 @@
+#include "ThinnedTrajectory.hh"
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4VPhysicalVolume.hh"
+
+G4ThreadLocal G4Allocator<ThinnedTrajectory>* thinnedTrajectoryAllocator = nullptr;
+
+ThinnedTrajectory::ThinnedTrajectory(const G4Track* track, G4int pointStride,
+                                     const G4LogicalVolume* target)
+    : G4Trajectory(track),
+      fStride(pointStride > 0 ? pointStride : 1),
+      fTarget(target)
+{}
+
+void ThinnedTrajectory::AppendStep(const G4Step* step)
+{
+    fNSteps++;
+    auto pv = step->GetPostStepPoint()->GetPhysicalVolume();
+    if (fTarget && pv && pv->GetLogicalVolume() == fTarget) fReachedTarget = true;
+
+    // 마지막 스텝 (흡수/검출/탈출) 은 항상 남김
+    if (fNSteps % fStride == 0 || step->GetTrack()->GetTrackStatus() != fAlive)
+        G4Trajectory::AppendStep(step);
+}
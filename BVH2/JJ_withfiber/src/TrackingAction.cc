@@ -0,0 +1,107 @@
+#include "TrackingAction.hh"
+#include "EventAction.hh"
+#include "PhotonTrackInformation.hh"
+#include "TrajectoryFilter.hh"
+#include "YieldScan.hh"
+#include "ThinnedTrajectory.hh"
+
+#include "G4Track.hh"
+#include "G4TrackVector.hh"
+#include "G4TrackingManager.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4EventManager.hh"
+#include "G4Event.hh"
+#include "G4LogicalVolumeStore.hh"
+
+TrackingAction::TrackingAction(EventAction* eventAction)
+    : G4UserTrackingAction(),
+      fEventAction(eventAction)
+{}
+
+TrackingAction::~TrackingAction() {}
+
+void TrackingAction::PreUserTrackingAction(const G4Track* track)
+{
+    // 이전 광자에서 끈 궤적 저장을 되돌림 (그사이 사용자가 바꿨으면 그대로)
+    if (fSavedStoreTrajectory >= 0) {
+        if (fpTrackingManager->GetStoreTrajectory() == 0)
+            fpTrackingManager->SetStoreTrajectory(fSavedStoreTrajectory);
+        fSavedStoreTrajectory = -1;
+    }
+    if (track->GetDefinition() != G4OpticalPhoton::OpticalPhotonDefinition()) return;
+
+    if (YieldScan::IsActive()) fEventAction->MarkPhotonOrigin(track);
+
+    if (TrajectoryFilter::IsActive() && fpTrackingManager->GetStoreTrajectory() != 0)
+        FilterTrajectory(track);
+
+    if (!fEventAction->RecordsPhotonPaths()) return;
+    if (!track->GetUserInformation())
+        track->SetUserInformation(new PhotonTrackInformation());
+}
+
+void TrackingAction::FilterTrajectory(const G4Track* track)
+{
+    const G4int eventID = G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetEventID();
+    if (eventID != fEventID) {
+        fEventID = eventID;
+        fNStored = 0;
+    }
+
+    const auto mode = TrajectoryFilter::GetMode();
+    G4bool keep = mode != TrajectoryFilter::kNone && fNStored < TrajectoryFilter::GetMaxPerEvent();
+    if (keep && mode == TrajectoryFilter::kSampled)
+        keep = TrajectoryFilter::SampleKey(eventID, track->GetTrackID()) < TrajectoryFilter::GetFraction();
+    if (!keep) {
+        SuppressTrajectory();
+        return;
+    }
+
+    if (mode == TrajectoryFilter::kVolume && fTargetName != TrajectoryFilter::GetVolumeName()) {
+        fTargetName = TrajectoryFilter::GetVolumeName();
+        fTargetVolume = G4LogicalVolumeStore::GetInstance()->GetVolume(fTargetName, false);
+    }
+    fpTrackingManager->SetTrajectory(
+        new ThinnedTrajectory(track, TrajectoryFilter::GetPointStride(),
+                              mode == TrajectoryFilter::kVolume ? fTargetVolume : nullptr));
+    fPhotonCountAtStart = fEventAction->GetPhotonCount();
+    fNStored++;
+}
+
+// 이 트랙의 궤적 생성/저장을 막음 (추적 끝이면 G4TrackingManager 가 궤적 삭제)
+void TrackingAction::SuppressTrajectory()
+{
+    if (fSavedStoreTrajectory < 0) fSavedStoreTrajectory = fpTrackingManager->GetStoreTrajectory();
+    fpTrackingManager->SetStoreTrajectory(0);
+}
+
+void TrackingAction::PostUserTrackingAction(const G4Track* track)
+{
+    if (track->GetDefinition() != G4OpticalPhoton::OpticalPhotonDefinition()) return;
+
+    if (TrajectoryFilter::DecidesAtTrackEnd()) {
+        auto trajectory = dynamic_cast<ThinnedTrajectory*>(fpTrackingManager->GimmeTrajectory());
+        if (trajectory) {
+            G4bool keep = (TrajectoryFilter::GetMode() == TrajectoryFilter::kDetected)
+                        ? fEventAction->GetPhotonCount() > fPhotonCountAtStart
+                        : trajectory->ReachedTarget();
+            if (!keep) {
+                SuppressTrajectory();
+                fNStored--;
+            }
+        }
+    }
+
+    if (!fEventAction->RecordsPhotonPaths()) return;
+    auto info = static_cast<PhotonTrackInformation*>(track->GetUserInformation());
+    if (!info) return;
+
+    // 광자가 만든 광자 = WLS 재방출 → 흡수 이전 경로를 이어받음
+    auto secondaries = fpTrackingManager->GimmeSecondaries();
+    if (!secondaries) return;
+    for (auto sec : *secondaries) {
+        if (sec->GetDefinition() != G4OpticalPhoton::OpticalPhotonDefinition()) continue;
+        if (!sec->GetUserInformation())
+            sec->SetUserInformation(new PhotonTrackInformation(*info));
+    }
+}
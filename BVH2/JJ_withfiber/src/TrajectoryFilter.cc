@@ -0,0 +1,55 @@
+#include "TrajectoryFilter.hh"
+
+#include "G4GenericMessenger.hh"
+
+#include <cstdint>
+
+TrajectoryFilter::Mode TrajectoryFilter::fMode = TrajectoryFilter::kAll;
+G4double               TrajectoryFilter::fFraction = 0.01;
+G4String               TrajectoryFilter::fVolumeName = "SiPMLogic";
+G4int                  TrajectoryFilter::fPointStride = 10;
+G4int                  TrajectoryFilter::fMaxPerEvent = 2000;
+
+TrajectoryFilter::TrajectoryFilter()
+{
+    DefineCommands();
+}
+
+TrajectoryFilter::~TrajectoryFilter()
+{
+    delete fMessenger;
+}
+
+void TrajectoryFilter::DefineCommands()
+{
+    fMessenger = new G4GenericMessenger(this, "/veto/trajectory/", "Optical photon trajectory filtering");
+    fMessenger->DeclareMethod("photons", &TrajectoryFilter::SetMode,
+                              "all | sampled | detected | volume | none")
+        .SetCandidates("all sampled detected volume none").SetToBeBroadcasted(false);
+    fMessenger->DeclareProperty("fraction", fFraction, "Stored fraction of photon trajectories (sampled)")
+        .SetParameterName("f", false).SetRange("f>=0 && f<=1").SetToBeBroadcasted(false);
+    fMessenger->DeclareProperty("volume", fVolumeName, "Logical volume a stored photon must enter (volume)")
+        .SetToBeBroadcasted(false);
+    fMessenger->DeclareProperty("pointStride", fPointStride, "Keep one trajectory point every n steps")
+        .SetParameterName("n", false).SetRange("n>0").SetToBeBroadcasted(false);
+    fMessenger->DeclareProperty("maxPerEvent", fMaxPerEvent, "Maximum stored photon trajectories per event")
+        .SetParameterName("n", false).SetRange("n>=0").SetToBeBroadcasted(false);
+}
+
+void TrajectoryFilter::SetMode(const G4String& mode)
+{
+    fMode = (mode == "sampled")  ? kSampled
+          : (mode == "detected") ? kDetected
+          : (mode == "volume")   ? kVolume
+          : (mode == "none")     ? kNone : kAll;
+}
+
+G4double TrajectoryFilter::SampleKey(G4int eventID, G4int trackID)
+{
+    // splitmix64
+    uint64_t z = (uint64_t(uint32_t(eventID)) << 32 | uint32_t(trackID)) + 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    z ^= z >> 31;
+    return (z >> 11) * (1.0 / 9007199254740992.0);
+}
@@ -0,0 +1,204 @@
+#include "WrapReflectanceTable.hh"
+
+#include "G4OpticalSurface.hh"
+#include "G4MaterialPropertiesTable.hh"
+#include "G4MaterialPropertyVector.hh"
+#include "G4RandomTools.hh"
+#include "G4Timer.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+WrapReflectanceTable* WrapReflectanceTable::Instance()
+{
+    static WrapReflectanceTable instance;
+    return &instance;
+}
+
+// ----------------------------------------------------------------------
+// 입력 → 균일 격자
+// ----------------------------------------------------------------------
+void WrapReflectanceTable::SetReflectance(const std::vector<G4double>& energies,
+                                          const std::vector<G4double>& values)
+{
+    fInE = energies; fInR = values;
+    fEmin  = energies.front();
+    fEstep = (energies.back() - energies.front()) / (kNEnergy - 1);
+    if (fEstep <= 0.) fEstep = 1.;
+
+    fReflectance.resize(kNEnergy);
+    std::size_t j = 0;
+    for (G4int i = 0; i < kNEnergy; i++) {
+        G4double e = fEmin + i*fEstep;
+        while (j + 2 < energies.size() && energies[j+1] < e) j++;
+        if (energies.size() == 1) { fReflectance[i] = values[0]; continue; }
+        G4double f = (e - energies[j]) / (energies[j+1] - energies[j]);
+        f = std::min(std::max(f, 0.), 1.);
+        fReflectance[i] = (1-f)*values[j] + f*values[j+1];
+    }
+}
+
+// 세기 I(cosθ) 의 cosθ 누적분포를 뒤집어 균일 u 격자의 cosθ 로
+void WrapReflectanceTable::SetAngular(const std::vector<G4double>& cosines,
+                                      const std::vector<G4double>& intensities)
+{
+    fInCos = cosines; fInI = intensities;
+
+    std::vector<G4double> cdf(cosines.size(), 0.);
+    for (std::size_t k = 1; k < cosines.size(); k++)
+        cdf[k] = cdf[k-1] + 0.5*(intensities[k] + intensities[k-1])*(cosines[k] - cosines[k-1]);
+    const G4double total = cdf.back();
+
+    fCosQuantile.resize(kNQuantile + 1);
+    std::size_t k = 0;
+    for (G4int q = 0; q <= kNQuantile; q++) {
+        G4double c = total * q / kNQuantile;
+        while (k + 2 < cdf.size() && cdf[k+1] < c) k++;
+        G4double span = cdf[k+1] - cdf[k];
+        G4double f = (span > 0.) ? (c - cdf[k]) / span : 0.;
+        f = std::min(std::max(f, 0.), 1.);
+        fCosQuantile[q] = cosines[k] + f*(cosines[k+1] - cosines[k]);
+    }
+}
+
+void WrapReflectanceTable::BuildFromSurface(const G4OpticalSurface* surface)
+{
+    auto mpt = surface ? surface->GetMaterialPropertiesTable() : nullptr;
+    auto refl = mpt ? mpt->GetProperty("REFLECTIVITY") : nullptr;
+    if (!refl) {
+        G4cout << "[WrapTable] surface has no REFLECTIVITY; table not built." << G4endl;
+        return;
+    }
+    std::vector<G4double> energies, values;
+    for (std::size_t i = 0; i < refl->GetVectorLength(); i++) {
+        energies.push_back(refl->Energy(i));
+        values.push_back((*refl)[i]);
+    }
+    SetReflectance(energies, values);
+
+    // Lambert: 단위 입체각당 세기 ∝ cosθ
+    std::vector<G4double> cosines, intensities;
+    for (G4int k = 0; k <= 64; k++) {
+        cosines.push_back(k / 64.);
+        intensities.push_back(k / 64.);
+    }
+    SetAngular(cosines, intensities);
+    fMeasured = false;
+    G4cout << "[WrapTable] built from " << surface->GetName() << " (Lambert, "
+           << energies.size() << " reflectivity points)" << G4endl;
+}
+
+// ----------------------------------------------------------------------
+// 상수 시간 샘플링
+// ----------------------------------------------------------------------
+G4double WrapReflectanceTable::Reflectance(G4double energy) const
+{
+    G4double x = (energy - fEmin) / fEstep;
+    if (x <= 0.) return fReflectance.front();
+    G4int i = G4int(x);
+    if (i >= kNEnergy - 1) return fReflectance.back();
+    G4double f = x - i;
+    return (1-f)*fReflectance[i] + f*fReflectance[i+1];
+}
+
+G4ThreeVector WrapReflectanceTable::SampleDirection(const G4ThreeVector& normal) const
+{
+    G4double x = G4UniformRand() * kNQuantile;
+    G4int q = std::min(G4int(x), kNQuantile - 1);
+    G4double f = x - q;
+    G4double cosT = (1-f)*fCosQuantile[q] + f*fCosQuantile[q+1];
+    G4double sinT = std::sqrt(std::max(0., 1.0 - cosT*cosT));
+    G4double phi  = CLHEP::twopi * G4UniformRand();
+
+    G4ThreeVector a = normal.orthogonal().unit();
+    G4ThreeVector b = normal.cross(a);
+    return sinT*std::cos(phi)*a + sinT*std::sin(phi)*b + cosT*normal;
+}
+
+// ----------------------------------------------------------------------
+// 텍스트 파일 입출력
+// ----------------------------------------------------------------------
+G4bool WrapReflectanceTable::Read(const G4String& fileName)
+{
+    std::ifstream in(fileName);
+    if (!in) return false;
+
+    std::vector<G4double> energies, values, cosines, intensities;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream is(line);
+        std::string tag;
+        G4double a, b;
+        if (!(is >> tag) || tag[0] == '#') continue;
+        if (!(is >> a >> b)) return false;
+        if (tag == "R")      { energies.push_back(a*eV); values.push_back(b); }
+        else if (tag == "A") { cosines.push_back(a);     intensities.push_back(b); }
+    }
+    if (energies.empty() || cosines.size() < 2) return false;
+    if (!std::is_sorted(energies.begin(), energies.end()) ||
+        !std::is_sorted(cosines.begin(), cosines.end())) return false;
+
+    SetReflectance(energies, values);
+    SetAngular(cosines, intensities);
+    fMeasured = true;
+    return true;
+}
+
+G4bool WrapReflectanceTable::Write(const G4String& fileName) const
+{
+    std::ofstream out(fileName);
+    if (!out || !IsLoaded()) return false;
+    out << "# WrapReflectanceTable\n# R <energy eV> <reflectance>\n";
+    for (std::size_t i = 0; i < fInE.size(); i++) out << "R " << fInE[i]/eV << " " << fInR[i] << "\n";
+    out << "# A <cos theta_out> <intensity per sr>\n";
+    for (std::size_t k = 0; k < fInCos.size(); k++) out << "A " << fInCos[k] << " " << fInI[k] << "\n";
+    return out.good();
+}
+
+// ----------------------------------------------------------------------
+// 반사 한 번: 흡수 판정 + 방향 + 편광 (경계 프로세스와 같은 순서)
+// ----------------------------------------------------------------------
+void WrapReflectanceTable::Benchmark(G4int nReflections) const
+{
+    if (!IsLoaded() || !fTarget || nReflections <= 0) {
+        G4cout << "[WrapTable] no table / surface; run /veto/surface/wrapModel table first." << G4endl;
+        return;
+    }
+    auto refl = fTarget->GetMaterialPropertiesTable()->GetProperty("REFLECTIVITY");
+    const G4double e0 = fEmin, e1 = fEmin + (kNEnergy - 1)*fEstep;
+    G4ThreeVector normal(0., 0., 1.), pol(1., 0., 0.);
+    G4ThreeVector oldDir(0., 0., -1.);
+
+    G4int kept[2] = {0, 0};
+    G4double rate[2] = {0., 0.};
+    for (G4int model = 0; model < 2; model++) {
+        G4Timer timer;
+        timer.Start();
+        for (G4int n = 0; n < nReflections; n++) {
+            G4double e = e0 + (e1 - e0)*G4UniformRand();
+            G4ThreeVector dir;
+            if (model == 0) {
+                if (!G4BooleanRand(refl->Value(e))) continue;
+                dir = G4LambertianRand(normal);
+            } else {
+                if (G4UniformRand() >= Reflectance(e)) continue;
+                dir = SampleDirection(normal);
+            }
+            // 편광: TabulatedBoundaryProcess 와 같은 facet (newDir - oldDir)
+            G4ThreeVector facet = (dir - oldDir).unit();
+            pol = (-pol + 2.*(pol*facet)*facet).unit();
+            // 다음 입사 = 맞은편 면에서 되돌아온 광자 (z 성분 반전)
+            oldDir.set(dir.x(), dir.y(), -dir.z());
+            kept[model]++;
+        }
+        timer.Stop();
+        rate[model] = nReflections / std::max(timer.GetRealElapsed(), 1e-9);
+    }
+    G4cout << "[WrapTable] " << nReflections << " reflections: analytic "
+           << rate[0]*1e-6 << " M/s, table " << rate[1]*1e-6 << " M/s"
+           << " (reflected " << kept[0] << " / " << kept[1] << ")" << G4endl;
+}
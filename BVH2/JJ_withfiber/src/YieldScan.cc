@@ -0,0 +1,44 @@
+#include "YieldScan.hh"
+
+#include "G4Material.hh"
+#include "G4MaterialPropertiesTable.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+
+const G4double YieldScan::kNominalYield = 10000./MeV;
+
+std::vector<G4double> YieldScan::fYields;
+G4double YieldScan::fMaxYield = YieldScan::kNominalYield;
+G4double YieldScan::fBaseYield = YieldScan::kNominalYield;
+
+void YieldScan::SetYields(const std::vector<G4double>& yields)
+{
+    fYields = yields;
+    fMaxYield = fYields.empty() ? fBaseYield
+                                : *std::max_element(fYields.begin(), fYields.end());
+    ApplyYield(fMaxYield);
+}
+
+void YieldScan::SetBaseYield(G4double yield)
+{
+    fBaseYield = yield;
+    SetYields({});
+}
+
+// G4Scintillation 은 스텝마다 MPT 의 상수를 읽으므로 물리 테이블 재구성 불필요
+void YieldScan::ApplyYield(G4double yield)
+{
+    auto scintMat = G4Material::GetMaterial("EJ212", false);
+    if (!scintMat || !scintMat->GetMaterialPropertiesTable()) return;
+    scintMat->GetMaterialPropertiesTable()->AddConstProperty("SCINTILLATIONYIELD", yield);
+}
+
+void YieldScan::Thin(const std::vector<G4double>& keys, G4int unthinned, std::vector<G4int>& npe)
+{
+    npe.assign(fYields.size(), unthinned);
+    for (std::size_t i = 0; i < fYields.size(); i++) {
+        G4double fraction = fYields[i] / fMaxYield;
+        for (auto u : keys) if (u < fraction) npe[i]++;
+    }
+}
@@ -0,0 +1,158 @@
+// ----------------------------------------------------------------------
+// ReweightNpe: 공칭 샘플 하나로 광학 파라미터 변화에 따른 npe 분포 재구성
+//
+//  입력: /veto/output/photonPaths true 로 만든 sipm_output.root (photonPaths 트리)
+//  광자 가중치 (likelihood ratio):
+//    w = Π_m exp(-tau_m (1/s_m - 1)) × (R'/R0)^nRefl
+//      s_m : 재질 m 흡수 길이 배율 (scint, core, clad, glue)
+//      R'  : 테플론 반사율 (R0 = 공칭값, 기본 0.98)
+//  이벤트 npe' = (경로 없는 광자 수) + Σ_i n_i,  n_i = floor(w_i) + Bernoulli(frac(w_i))
+//    → 평균은 정확, w > 1 광자는 복제 근사 (분산 약간 과대)
+//  유효 통계: Kish ESS = (Σw)² / Σw²  — ESS/N 이 작으면 공칭에서 너무 먼 변화
+//
+//  사용법:
+//    ReweightNpe <input.root> <output.root> [--refl0 0.98] [--seed 1234]
+//                "scint=0.8,refl=0.95" "core=1.2" ...
+// ----------------------------------------------------------------------
+#include "TFile.h"
+#include "TTree.h"
+#include "TH1F.h"
+#include "TRandom3.h"
+#include "TString.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    const int kNMedia = 4;
+    const char* kTauNames[kNMedia] = {"tauScint", "tauCore", "tauClad", "tauGlue"};
+    const char* kKeys[kNMedia]     = {"scint", "core", "clad", "glue"};
+    const double kMinESSFraction   = 0.5;
+
+    struct Variation {
+        std::string label;
+        double scale[kNMedia] = {1., 1., 1., 1.};
+        double refl = -1.;        // < 0 이면 공칭값 유지
+        TH1F*  hNpe = nullptr;
+        double sumW = 0., sumW2 = 0., nCloned = 0.;
+    };
+
+    bool ParseVariation(const std::string& spec, Variation& v)
+    {
+        v.label = spec;
+        std::istringstream is(spec);
+        std::string item;
+        while (std::getline(is, item, ',')) {
+            auto eq = item.find('=');
+            if (eq == std::string::npos) return false;
+            std::string key = item.substr(0, eq);
+            double value = std::atof(item.substr(eq + 1).c_str());
+            if (key == "refl") { v.refl = value; continue; }
+            bool found = false;
+            for (int m = 0; m < kNMedia; m++)
+                if (key == kKeys[m]) { v.scale[m] = value; found = true; }
+            if (!found || value <= 0.) return false;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 4) {
+        std::cerr << "usage: " << argv[0] << " <input.root> <output.root> [--refl0 R] [--seed N]"
+                  << " \"scint=0.8,refl=0.95\" ..." << std::endl;
+        return 1;
+    }
+
+    double refl0 = 0.98;
+    unsigned seed = 1234;
+    std::vector<Variation> vars;
+    for (int i = 3; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--refl0" && i + 1 < argc) { refl0 = std::atof(argv[++i]); continue; }
+        if (arg == "--seed"  && i + 1 < argc) { seed = std::atoi(argv[++i]); continue; }
+        Variation v;
+        if (!ParseVariation(arg, v)) {
+            std::cerr << "bad variation: " << arg << std::endl;
+            return 1;
+        }
+        vars.push_back(v);
+    }
+
+    TFile in(argv[1], "READ");
+    auto tree = in.IsOpen() ? static_cast<TTree*>(in.Get("photonPaths")) : nullptr;
+    if (!tree) {
+        std::cerr << "no photonPaths tree in " << argv[1]
+                  << " (run with /veto/output/photonPaths true)" << std::endl;
+        return 1;
+    }
+
+    int npe = 0;
+    std::vector<float>* tau[kNMedia] = {};
+    std::vector<int>*   nRefl = nullptr;
+    tree->SetBranchAddress("npe", &npe);
+    for (int m = 0; m < kNMedia; m++) tree->SetBranchAddress(kTauNames[m], &tau[m]);
+    tree->SetBranchAddress("nRefl", &nRefl);
+
+    TFile out(argv[2], "RECREATE");
+    auto hNominal = new TH1F("hNpe", "Number of photoelectrons per event (nominal)", 80, 0, 80);
+    for (std::size_t k = 0; k < vars.size(); k++) {
+        vars[k].hNpe = new TH1F(Form("hNpe_var%zu", k),
+                                Form("Number of photoelectrons per event (%s)", vars[k].label.c_str()),
+                                80, 0, 80);
+    }
+
+    TRandom3 rng(seed);
+    long nPhotons = 0;
+    double sumNominal = 0.;
+    const Long64_t nEvents = tree->GetEntries();
+
+    for (Long64_t e = 0; e < nEvents; e++) {
+        tree->GetEntry(e);
+        const std::size_t n = nRefl->size();
+        nPhotons += n;
+        sumNominal += npe;
+        hNominal->Fill(npe);
+
+        for (auto& v : vars) {
+            const double reflRatio = (v.refl >= 0.) ? v.refl / refl0 : 1.;
+            int npeVar = npe - int(n); // 경로 정보가 없는 광자는 그대로
+            for (std::size_t i = 0; i < n; i++) {
+                double logW = 0.;
+                for (int m = 0; m < kNMedia; m++)
+                    logW -= (*tau[m])[i] * (1.0/v.scale[m] - 1.0);
+                double w = std::exp(logW) * std::pow(reflRatio, (*nRefl)[i]);
+                v.sumW += w;
+                v.sumW2 += w*w;
+                double whole = std::floor(w);
+                if (w > 1.) v.nCloned++;
+                npeVar += int(whole) + (rng.Uniform() < w - whole ? 1 : 0);
+            }
+            v.hNpe->Fill(npeVar);
+        }
+    }
+
+    std::cout << "======================= Reweighting =======================" << std::endl;
+    std::cout << "Events: " << nEvents << "  detected photons with path: " << nPhotons
+              << "  nominal <npe>: " << (nEvents ? sumNominal/nEvents : 0.) << std::endl;
+    for (const auto& v : vars) {
+        double ess = (v.sumW2 > 0.) ? v.sumW*v.sumW / v.sumW2 : 0.;
+        double essFrac = nPhotons ? ess / nPhotons : 0.;
+        double meanShift = nEvents ? (v.sumW - nPhotons) / nEvents : 0.;
+        std::cout << v.label
+                  << "  <npe>: " << (nEvents ? sumNominal/nEvents : 0.) + meanShift
+                  << "  ESS/N: " << essFrac
+                  << "  cloned: " << (nPhotons ? v.nCloned/nPhotons : 0.)
+                  << (essFrac < kMinESSFraction ? "  [WARNING: too far from nominal]" : "")
+                  << std::endl;
+    }
+
+    out.Write();
+    out.Close();
+    return 0;
+}